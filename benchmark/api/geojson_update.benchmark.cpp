@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// A live fleet: assets scattered around the map center, with a few of them reporting
+// a new position between frames.
+class GeoJSONUpdateBenchmark {
+public:
+    static constexpr std::size_t assetCount = 20000;
+
+    GeoJSONUpdateBenchmark(style::GeoJSONOptions options = {}) {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+
+        map.setStyleJSON(R"STYLE({ "version": 8, "sources": {}, "layers": [] })STYLE");
+
+        for (std::size_t i = 0; i < assetCount; ++i) {
+            assets.push_back(makeAsset(i));
+        }
+
+        auto source = std::make_unique<style::GeoJSONSource>("assets", options);
+        source->setGeoJSON(GeoJSON{ assets });
+        map.addSource(std::move(source));
+        map.addLayer(std::make_unique<style::CircleLayer>("assets", "assets"));
+        map.setLatLngZoom({ 0, 0 }, 10);
+
+        mbgl::benchmark::render(map, view);
+    }
+
+    // Moves `count` random assets and returns their new state.
+    FeatureCollection move(std::size_t count) {
+        std::uniform_int_distribution<std::size_t> pick(0, assetCount - 1);
+
+        FeatureCollection moved;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t index = pick(generator);
+            assets[index] = makeAsset(index);
+            moved.push_back(assets[index]);
+        }
+        return moved;
+    }
+
+    style::GeoJSONSource& source() {
+        return *map.getSource("assets")->as<style::GeoJSONSource>();
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+
+    FeatureCollection assets;
+
+private:
+    mapbox::geometry::feature<double> makeAsset(std::size_t index) {
+        mapbox::geometry::feature<double> feature { mapbox::geometry::point<double>{ position(generator), position(generator) } };
+        feature.id = uint64_t(index);
+        return feature;
+    }
+
+    std::mt19937 generator{ 42 };
+    std::uniform_real_distribution<double> position{ -2, 2 };
+};
+
+} // end namespace
+
+// Baseline: sends all assets again whenever some of them moved.
+static void API_geoJSONSetGeoJSON(::benchmark::State& state) {
+    GeoJSONUpdateBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.move(state.range_x());
+        bench.source().setGeoJSON(GeoJSON{ bench.assets });
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+}
+
+// Sends only the assets that moved.
+static void API_geoJSONUpsertFeatures(::benchmark::State& state) {
+    GeoJSONUpdateBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.source().upsertFeatures(bench.move(state.range_x()));
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+}
+
+// Sends only the assets that moved to a clustered source. Supercluster copies the features into
+// its index, so clustered sources hold the features twice and copy all of them on every update.
+static void API_geoJSONUpsertFeaturesClustered(::benchmark::State& state) {
+    style::GeoJSONOptions options;
+    options.cluster = true;
+    GeoJSONUpdateBenchmark bench(options);
+
+    while (state.KeepRunning()) {
+        bench.source().upsertFeatures(bench.move(state.range_x()));
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+}
+
+BENCHMARK(API_geoJSONSetGeoJSON)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(API_geoJSONUpsertFeatures)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(API_geoJSONUpsertFeaturesClustered)->Arg(10)->Arg(100)->Arg(1000);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// Fill, line and circle layers of a source whose tiles end at z15, the zoom level of the tiles in
+// the cache. The name distinguishes otherwise identical styles, which the map would not reload.
+std::string overscaleStyle(const std::string& name) {
+    return R"STYLE({
+        "version": 8,
+        "name": ")STYLE" + name + R"STYLE(",
+        "sources": {
+            "composite": {
+                "type": "vector",
+                "tiles": [ "mapbox://tiles/mapbox.mapbox-terrain-v2,mapbox.mapbox-streets-v7/{z}/{x}/{y}.vector.pbf" ],
+                "maxzoom": 15
+            }
+        },
+        "layers": [
+            { "id": "landuse", "type": "fill", "source": "composite", "source-layer": "landuse",
+              "paint": { "fill-color": "#d8e8c8" } },
+            { "id": "landuse_overlay", "type": "fill", "source": "composite", "source-layer": "landuse_overlay",
+              "paint": { "fill-color": "#c8d8e8" } },
+            { "id": "building", "type": "fill", "source": "composite", "source-layer": "building",
+              "paint": { "fill-color": "#dfdbd7", "fill-outline-color": "#cfcbc7" } },
+            { "id": "road", "type": "line", "source": "composite", "source-layer": "road",
+              "layout": { "line-join": "round" }, "paint": { "line-color": "#ffffff", "line-width": 4 } },
+            { "id": "poi", "type": "circle", "source": "composite", "source-layer": "poi_label",
+              "paint": { "circle-color": "#ff0000", "circle-radius": 3 } }
+        ]
+    })STYLE";
+}
+
+class OverscaleBenchmark {
+public:
+    OverscaleBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 16); // Manhattan
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+};
+
+} // end namespace
+
+// Zooms in from z16 to z20 over z15 tiles after loading the style, so that every zoom level lays
+// out tiles that are overscaled from the same canonical tiles as the ones of the level before.
+static void API_renderOverscaledZoomIn(::benchmark::State& state) {
+    OverscaleBenchmark bench;
+    const std::string styles[] = { overscaleStyle("a"), overscaleStyle("b") };
+
+    std::size_t iteration = 0;
+    while (state.KeepRunning()) {
+        bench.map.setStyleJSON(styles[iteration++ % 2]);
+        for (double zoom = 16; zoom <= 20; zoom++) {
+            bench.map.setZoom(zoom);
+            mbgl::benchmark::render(bench.map, bench.view);
+        }
+    }
+}
+
+BENCHMARK(API_renderOverscaledZoomIn);
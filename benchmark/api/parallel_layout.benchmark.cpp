@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/sprite/sprite_image.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// Two dense z15 tiles of a style with close to 200 layers, so that there are fewer tiles
+// than threads.
+class ParallelLayoutBenchmark {
+public:
+    ParallelLayoutBenchmark(bool parallel) {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+
+        map.setParallelTileLayout(parallel);
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+    }
+
+    // The map only reloads a style that differs from the current one.
+    void reloadStyle() {
+        map.setStyleJSON(styles[reloads++ % 2]);
+
+        auto decoded = decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png"));
+        map.addImage("test-icon", std::make_unique<SpriteImage>(std::move(decoded), 1.0));
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+
+    const std::string style = util::read_file("benchmark/fixtures/api/query_style.json");
+    const std::string styles[2] = { style, style + "\n" };
+    std::size_t reloads = 0;
+};
+
+} // end namespace
+
+static void API_renderStillParallelLayout(::benchmark::State& state) {
+    ParallelLayoutBenchmark bench(state.range_x());
+
+    while (state.KeepRunning()) {
+        bench.reloadStyle();
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+
+    state.SetLabel(state.range_x() ? "parallel" : "sequential");
+}
+
+BENCHMARK(API_renderStillParallelLayout)->Arg(0)->Arg(1)->UseRealTime();
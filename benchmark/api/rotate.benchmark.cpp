@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <ctime>
+
+using namespace mbgl;
+
+namespace {
+
+// Renders whenever the map asks for it, like a platform view in continuous mode would.
+class ContinuousBackend : public HeadlessBackend {
+public:
+    void invalidate() override {
+        invalidated = true;
+    }
+
+    bool invalidated = true;
+};
+
+double cpuTime(clockid_t clock) {
+    timespec time;
+    clock_gettime(clock, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// CPU time of all threads but the calling one, i.e. of the workers when called on the map thread.
+double workerCPUTime() {
+    return cpuTime(CLOCK_PROCESS_CPUTIME_ID) - cpuTime(CLOCK_THREAD_CPUTIME_ID);
+}
+
+class RotateBenchmark {
+public:
+    RotateBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        fileSource.setAccessToken("foobar");
+
+        map.setStyleJSON(util::read_file("benchmark/fixtures/api/query_style.json"));
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+
+        renderUntilSettled();
+    }
+
+    // Renders frames until the camera has stopped and every tile is placed for its final
+    // position. Returns the CPU time the workers spent in the meantime.
+    double renderUntilSettled() {
+        const double start = workerCPUTime();
+        while (map.isRotating() || !map.isFullyLoaded() || backend.invalidated) {
+            loop.runOnce();
+            if (backend.invalidated) {
+                backend.invalidated = false;
+                BackendScope scope(backend);
+                map.render(view);
+            }
+        }
+        return workerCPUTime() - start;
+    }
+
+    util::RunLoop loop;
+    ContinuousBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Continuous };
+};
+
+const Duration animationDuration = Milliseconds(300);
+
+} // end namespace
+
+// Animates the map through a rotation of range_x degrees, rendering every frame, and reports
+// the CPU time the workers spend on it per degree. While the camera moves, tiles may keep a
+// placement close to the current one, so most of that time is the final placement.
+static void API_renderRotated(::benchmark::State& state) {
+    RotateBenchmark bench;
+    const double degrees = state.range_x();
+    double bearing = 0;
+
+    while (state.KeepRunning()) {
+        bearing += degrees;
+        bench.map.setBearing(bearing, AnimationOptions(animationDuration));
+        state.SetIterationTime(bench.renderUntilSettled() / degrees);
+    }
+
+    state.SetLabel("worker CPU per degree");
+}
+
+// Same as above, but tilting the map back and forth.
+static void API_renderPitched(::benchmark::State& state) {
+    RotateBenchmark bench;
+    const double degrees = state.range_x();
+    double pitch = 0;
+
+    while (state.KeepRunning()) {
+        pitch = pitch > 0 ? 0 : degrees;
+        bench.map.setPitch(pitch, AnimationOptions(animationDuration));
+        state.SetIterationTime(bench.renderUntilSettled() / degrees);
+    }
+
+    state.SetLabel("worker CPU per degree");
+}
+
+BENCHMARK(API_renderRotated)->Arg(1)->Arg(5)->Arg(50)->UseManualTime();
+BENCHMARK(API_renderPitched)->Arg(1)->Arg(5)->Arg(50)->UseManualTime();
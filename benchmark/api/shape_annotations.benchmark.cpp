@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/annotation/annotation.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Route segments around the map center, each one in a different color.
+class ShapeAnnotationBenchmark {
+public:
+    ShapeAnnotationBenchmark(std::size_t count) {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+
+        map.setStyleJSON(R"STYLE({ "version": 8, "sources": {}, "layers": [] })STYLE");
+        map.setLatLngZoom({ 0, 0 }, 4);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const double offset = double(i % 100) / 10 - 5;
+            LineAnnotation annotation { LineString<double> {{ { -10, offset }, { 10, offset + double(i / 100) / 10 } }} };
+            annotation.color = Color { float(i % 256) / 255, 0, 0, 1 };
+            annotation.width = { 2 };
+            map.addAnnotation(annotation);
+        }
+
+        mbgl::benchmark::render(map, view);
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+};
+
+} // end namespace
+
+static void API_renderLineAnnotations(::benchmark::State& state) {
+    ShapeAnnotationBenchmark bench(state.range_x());
+
+    while (state.KeepRunning()) {
+        mbgl::benchmark::render(bench.map, bench.view);
+    }
+
+    std::size_t layers = 0;
+    for (const auto& layer : bench.map.getLayers()) {
+        if (layer->getID().find("com.mapbox.annotations.shape.") == 0) {
+            layers++;
+        }
+    }
+    state.SetLabel(util::toString(layers) + " layers");
+}
+
+BENCHMARK(API_renderLineAnnotations)->Arg(10)->Arg(1000)->Arg(5000);
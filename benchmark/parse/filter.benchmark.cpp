@@ -6,9 +6,13 @@
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 
 #include <rapidjson/document.h>
 
+#include <memory>
+
 using namespace mbgl;
 
 style::Filter parse(const char* expression) {
@@ -37,5 +41,79 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+namespace {
+
+struct TileLayerFilter {
+    const char* tile;
+    const char* layer;
+    const char* filter;
+};
+
+// Filters from the streets style, applied to every feature of the source layer they select.
+const TileLayerFilter tileLayerFilters[] = {
+    { "0-0-0", "admin", R"FILTER(["all", ["<=", "admin_level", 2], ["==", "maritime", 0], ["==", "disputed", 0]])FILTER" },
+    { "10-163-395", "landcover", R"FILTER(["in", "class", "wood", "scrub", "grass", "crop"])FILTER" },
+    { "10-163-395", "road", R"FILTER(["all", ["in", "class", "motorway", "trunk", "primary"], ["!=", "structure", "tunnel"], ["!has", "oneway"]])FILTER" },
+    { "10-163-395", "place_label", R"FILTER(["all", ["==", "type", "city"], ["<=", "scalerank", 3], ["has", "name_en"]])FILTER" },
+};
+
+std::unique_ptr<GeometryTileData> loadTile(const char* name) {
+    return std::make_unique<VectorTileData>(std::make_shared<std::string>(
+        util::read_file(std::string("test/fixtures/api/assets/streets/") + name + ".vector.pbf")));
+}
+
+} // end namespace
+
+// Looks up each key by name for every feature.
+static void Parse_EvaluateFilterVectorTile(benchmark::State& state) {
+    const TileLayerFilter& test = tileLayerFilters[state.range_x()];
+    const style::Filter filter = parse(test.filter);
+    const auto data = loadTile(test.tile);
+    const GeometryTileLayer& layer = *data->getLayer(test.layer);
+
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+    for (std::size_t i = 0; i < layer.featureCount(); i++) {
+        features.push_back(layer.getFeature(i));
+    }
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(filter(feature->getType(), feature->getID(), [&] (const std::string& key) {
+                return feature->getValue(key);
+            }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * features.size());
+    state.SetLabel(test.layer);
+}
+
+// Resolves each key against the layer's key table once.
+static void Parse_EvaluateFilterVectorTileKeys(benchmark::State& state) {
+    const TileLayerFilter& test = tileLayerFilters[state.range_x()];
+    const style::Filter filter = parse(test.filter);
+    const auto data = loadTile(test.tile);
+    const GeometryTileLayer& layer = *data->getLayer(test.layer);
+
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+    for (std::size_t i = 0; i < layer.featureCount(); i++) {
+        features.push_back(layer.getFeature(i));
+    }
+
+    while (state.KeepRunning()) {
+        GeometryTileLayerKeys keys;
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(filter(feature->getType(), feature->getID(), [&] (const std::string& key) {
+                return keys.getValue(*feature, key);
+            }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * features.size());
+    state.SetLabel(test.layer);
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateFilterVectorTile)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK(Parse_EvaluateFilterVectorTileKeys)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/allocations.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+struct TileLayerKeys {
+    const char* tile;
+    const char* layer;
+    std::vector<std::string> keys;
+};
+
+// Source layers of the streets tiles, with the keys the streets style reads from them.
+const TileLayerKeys tileLayerKeys[] = {
+    { "0-0-0", "admin", { "admin_level", "maritime", "disputed" } },
+    { "10-163-395", "landcover", { "class" } },
+    { "10-163-395", "road", { "class", "structure", "oneway" } },
+    { "10-163-395", "place_label", { "type", "scalerank", "name_en" } },
+    { "10-163-395", "poi_label", { "maki", "scalerank", "name_en" } },
+};
+
+std::shared_ptr<const std::string> readTile(const char* name) {
+    return std::make_shared<std::string>(
+        util::read_file(std::string("test/fixtures/api/assets/streets/") + name + ".vector.pbf"));
+}
+
+} // end namespace
+
+// Parses the layer directory and the key and value tables, and reads the style's keys from
+// every feature of the layer.
+static void Parse_VectorTileLayer(::benchmark::State& state) {
+    const TileLayerKeys& test = tileLayerKeys[state.range_x()];
+    const auto pbf = readTile(test.tile);
+
+    std::size_t allocations = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+
+        VectorTileData data(pbf);
+        const GeometryTileLayer* layer = data.getLayer(test.layer);
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            for (const auto& key : test.keys) {
+                ::benchmark::DoNotOptimize(feature->lookupValue(key));
+            }
+        }
+
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " + util::toString(allocations) + " allocations");
+}
+
+// Reads the style's keys from every feature of an already parsed layer, whose values have
+// been decoded by an earlier read, and reports the allocations per read. Values are read in
+// place, so there should be none.
+static void Parse_VectorTileValues(::benchmark::State& state) {
+    const TileLayerKeys& test = tileLayerKeys[state.range_x()];
+    VectorTileData data(readTile(test.tile));
+    const GeometryTileLayer* layer = data.getLayer(test.layer);
+
+    util::MonotonicArena arena(1024);
+    GeometryTileLayerKeys keys;
+    auto readAll = [&] {
+        std::size_t reads = 0;
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            arena.reset();
+            const GeometryTileFeature& feature = layer->makeFeature(i, arena);
+            for (const auto& key : test.keys) {
+                ::benchmark::DoNotOptimize(keys.getValue(feature, key));
+                reads++;
+            }
+        }
+        return reads;
+    };
+    readAll();
+
+    std::size_t allocations = 0;
+    std::size_t reads = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+        reads = readAll();
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " +
+                   util::toString(double(allocations) / reads) + " allocations per read");
+}
+
+// Makes each feature of an already parsed layer on the heap.
+static void Parse_VectorTileFeatureHeap(::benchmark::State& state) {
+    const TileLayerKeys& test = tileLayerKeys[state.range_x()];
+    VectorTileData data(readTile(test.tile));
+    const GeometryTileLayer* layer = data.getLayer(test.layer);
+
+    std::size_t allocations = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            ::benchmark::DoNotOptimize(feature->getType());
+        }
+
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " + util::toString(allocations) + " allocations");
+}
+
+// Makes the same features in an arena that is reset for every feature, like the worker does
+// for non-symbol layers.
+static void Parse_VectorTileFeatureArena(::benchmark::State& state) {
+    const TileLayerKeys& test = tileLayerKeys[state.range_x()];
+    VectorTileData data(readTile(test.tile));
+    const GeometryTileLayer* layer = data.getLayer(test.layer);
+
+    std::size_t allocations = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+
+        util::MonotonicArena arena(1024);
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            arena.reset();
+            const GeometryTileFeature& feature = layer->makeFeature(i, arena);
+            ::benchmark::DoNotOptimize(feature.getType());
+        }
+
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " + util::toString(allocations) + " allocations");
+}
+
+BENCHMARK(Parse_VectorTileLayer)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(Parse_VectorTileValues)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(Parse_VectorTileFeatureHeap)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(Parse_VectorTileFeatureArena)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4);
+
+namespace {
+
+struct TileLayerBucket {
+    const char* tile;
+    const char* layer;
+    bool fill;
+};
+
+const TileLayerBucket tileLayerBuckets[] = {
+    { "10-163-395", "water", true },
+    { "0-0-0", "admin", false },
+    { "10-163-395", "landcover", true },
+    { "10-163-395", "road", false },
+};
+
+std::unique_ptr<Bucket> createBucket(const TileLayerBucket& test) {
+    const style::BucketParameters parameters { { 0, 0, 0 }, MapMode::Continuous };
+    if (test.fill) {
+        return std::make_unique<FillBucket>(parameters, std::vector<const style::Layer*>());
+    } else {
+        return std::make_unique<LineBucket>(parameters, std::vector<const style::Layer*>(), style::LineLayoutProperties());
+    }
+}
+
+} // end namespace
+
+// Builds the vertices of a fill or line layer from each feature's GeometryCollection.
+static void Parse_VectorTileGeometryCollection(::benchmark::State& state) {
+    const TileLayerBucket& test = tileLayerBuckets[state.range_x()];
+    VectorTileData data(readTile(test.tile));
+    const GeometryTileLayer* layer = data.getLayer(test.layer);
+
+    std::size_t allocations = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+
+        auto bucket = createBucket(test);
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            bucket->addFeature(*feature, feature->getGeometries());
+        }
+
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " + util::toString(allocations) + " allocations");
+}
+
+// Builds the same vertices from geometry decoded one line at a time into a reused buffer.
+static void Parse_VectorTileGeometryVisitor(::benchmark::State& state) {
+    const TileLayerBucket& test = tileLayerBuckets[state.range_x()];
+    VectorTileData data(readTile(test.tile));
+    const GeometryTileLayer* layer = data.getLayer(test.layer);
+
+    std::size_t allocations = 0;
+    while (state.KeepRunning()) {
+        mbgl::benchmark::AllocationCounter counter;
+
+        auto bucket = createBucket(test);
+        GeometryCoordinates buffer;
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            feature->visitGeometries(buffer, [&] (const GeometryCoordinates& geometry) {
+                bucket->addGeometry(geometry);
+            });
+            bucket->finishFeature(*feature);
+        }
+
+        allocations = counter.count();
+    }
+
+    state.SetLabel(std::string(test.layer) + ", " + util::toString(allocations) + " allocations");
+}
+
+BENCHMARK(Parse_VectorTileGeometryCollection)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK(Parse_VectorTileGeometryVisitor)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
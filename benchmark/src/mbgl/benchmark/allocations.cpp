@@ -0,0 +1,45 @@
+#include <mbgl/benchmark/allocations.hpp>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// The allocation count of the innermost counter of this thread, if any. Constant initialized,
+// so reading it doesn't allocate.
+thread_local std::size_t* currentCount = nullptr;
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (currentCount) {
+        ++*currentCount;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace mbgl {
+namespace benchmark {
+
+AllocationCounter::AllocationCounter()
+    : previous(currentCount) {
+    currentCount = &allocations;
+}
+
+AllocationCounter::~AllocationCounter() {
+    currentCount = previous;
+}
+
+} // namespace benchmark
+} // namespace mbgl
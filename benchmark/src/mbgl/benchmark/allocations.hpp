@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+namespace benchmark {
+
+// Counts the calls to operator new made by the current thread while the counter exists.
+// Allocations of other threads, and of benchmarks that don't create a counter, aren't
+// counted.
+class AllocationCounter {
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    std::size_t count() const { return allocations; }
+
+private:
+    std::size_t allocations = 0;
+    std::size_t* previous;
+};
+
+} // namespace benchmark
+} // namespace mbgl
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string urlTemplate = "mapbox://tiles/mapbox.mapbox-terrain-v2,mapbox.mapbox-streets-v7/{z}/{x}/{y}.vector.pbf";
+
+// The tiles stored in the fixture.
+const std::vector<Resource> tiles = {
+    Resource::tile(urlTemplate, 1, 9648, 12318, 15, Tileset::Scheme::XYZ),
+    Resource::tile(urlTemplate, 1, 9649, 12318, 15, Tileset::Scheme::XYZ),
+};
+
+const std::size_t readsPerThread = 100;
+
+// Opening a database migrates it to the current schema, so the benchmark works on a copy of
+// the fixture that it removes again, along with its journal.
+class ScratchDatabase {
+public:
+    ScratchDatabase(const std::string& fixture, std::string path_) : path(std::move(path_)) {
+        remove();
+        util::write_file(path, util::read_file(fixture));
+    }
+
+    ~ScratchDatabase() {
+        remove();
+    }
+
+    const std::string path;
+
+private:
+    void remove() {
+        for (const auto& suffix : { "", "-wal", "-shm" }) {
+            std::remove((path + suffix).c_str());
+        }
+    }
+};
+
+} // end namespace
+
+// Reads tiles from the offline database on several threads at once.
+static void Storage_OfflineDatabase_concurrentTileReads(::benchmark::State& state) {
+    ScratchDatabase scratch("benchmark/fixtures/api/cache.db", "benchmark/fixtures/api/scratch.db");
+    OfflineDatabase db(scratch.path);
+    const std::size_t threadCount = state.range_x();
+
+    while (state.KeepRunning()) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([&, i] {
+                for (std::size_t j = 0; j < readsPerThread; j++) {
+                    ::benchmark::DoNotOptimize(db.get(tiles[(i + j) % tiles.size()]));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * threadCount * readsPerThread);
+}
+
+BENCHMARK(Storage_OfflineDatabase_concurrentTileReads)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
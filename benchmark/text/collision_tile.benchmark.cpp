@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// A dense POI tile: labels scattered over the tile, many of them colliding.
+std::vector<CollisionFeature> makeFeatures(std::size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(0, util::EXTENT);
+
+    std::vector<CollisionFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        features.emplace_back(GeometryCoordinates(), Anchor(position(generator), position(generator), 0, 0.5f),
+                              -12, 12, -60, 60, 2, 2, style::SymbolPlacementType::Point,
+                              IndexedSubfeature { uint32_t(i), 0, 0, uint32_t(i) }, false);
+    }
+    return features;
+}
+
+} // end namespace
+
+static void Placement_CollisionTile(::benchmark::State& state) {
+    std::vector<CollisionFeature> features = makeFeatures(state.range_x());
+
+    while (state.KeepRunning()) {
+        CollisionTile collisionTile(PlacementConfig { 0.3f, 0.5f });
+        for (auto& feature : features) {
+            const float scale = collisionTile.placeFeature(feature, false, true);
+            collisionTile.insertFeature(feature, scale, false);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * features.size());
+}
+
+static void Placement_QueryRenderedSymbols(::benchmark::State& state) {
+    std::vector<CollisionFeature> features = makeFeatures(state.range_x());
+    CollisionTile collisionTile(PlacementConfig { 0.3f, 0.5f });
+    for (auto& feature : features) {
+        const float scale = collisionTile.placeFeature(feature, false, true);
+        collisionTile.insertFeature(feature, scale, false);
+    }
+
+    const GeometryCoordinates query { { 4000, 4000 }, { 4200, 4000 }, { 4200, 4200 }, { 4000, 4200 } };
+
+    while (state.KeepRunning()) {
+        collisionTile.queryRenderedSymbols(query, 1.0f);
+    }
+}
+
+BENCHMARK(Placement_CollisionTile)->Arg(500)->Arg(5000);
+BENCHMARK(Placement_QueryRenderedSymbols)->Arg(500)->Arg(5000);
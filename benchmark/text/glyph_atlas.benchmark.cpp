@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/glyph_set.hpp>
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+class NullFileSource : public FileSource {
+public:
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override {
+        return nullptr;
+    }
+};
+
+// Street labels shaped with a font of the printable ASCII glyphs, the way symbol layouts on
+// several workers do it at the same time.
+class LabelLayoutBenchmark {
+public:
+    LabelLayoutBenchmark() {
+        GlyphSet glyphs;
+        for (uint32_t id = 32; id < 127; ++id) {
+            AlphaImage bitmap({ 10 + 2 * SDFGlyph::borderSize, 14 + 2 * SDFGlyph::borderSize });
+            bitmap.fill(uint8_t(id));
+            glyphs.insert(id, SDFGlyph{ id, std::move(bitmap), { 10, 14, 0, -14, 12 } });
+        }
+        glyphAtlas.addGlyphSet(fontStack, glyphs);
+    }
+
+    util::RunLoop loop;
+    NullFileSource fileSource;
+    GlyphAtlas glyphAtlas{ { 1024, 1024 }, fileSource };
+
+    const FontStack fontStack{ "Open Sans Regular" };
+    const std::vector<std::u16string> labels{
+        u"Main Street", u"Avenue of the Americas", u"Broadway", u"West 42nd Street",
+        u"Lexington Avenue", u"Franklin D. Roosevelt East River Drive", u"Canal Street",
+        u"Park Avenue South", u"Houston Street", u"Brooklyn Bridge Promenade"
+    };
+};
+
+std::unique_ptr<LabelLayoutBenchmark> bench;
+
+} // end namespace
+
+static void Layout_ShapeLabels(::benchmark::State& state) {
+    if (state.thread_index == 0) {
+        bench = std::make_unique<LabelLayoutBenchmark>();
+    }
+
+    BiDi bidi;
+    util::MonotonicArena arena;
+    const uintptr_t tileUID = state.thread_index + 1;
+    const float oneEm = 24.0f;
+
+    while (state.KeepRunning()) {
+        arena.reset();
+        auto glyphSet = bench->glyphAtlas.getGlyphSet(bench->fontStack);
+        for (const auto& label : bench->labels) {
+            GlyphPositions face;
+            const Shaping shaping = glyphSet->getShaping(label, 10 * oneEm, 1.2f * oneEm, 0.5f, 0.5f, 0.5f, 0,
+                                                         { 0, 0 }, oneEm, WritingModeType::Horizontal, bidi, arena);
+            if (shaping) {
+                bench->glyphAtlas.addGlyphs(tileUID, label, bench->fontStack, *glyphSet, face);
+            }
+            ::benchmark::DoNotOptimize(face);
+        }
+    }
+
+    if (state.thread_index == 0) {
+        bench.reset();
+    }
+}
+
+BENCHMARK(Layout_ShapeLabels)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
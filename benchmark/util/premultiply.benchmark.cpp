@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// The scalar loops that `premultiply` and `unpremultiply` used before they were vectorized.
+// Kept here as a baseline for comparison.
+PremultipliedImage premultiplyScalar(UnassociatedImage&& src) {
+    PremultipliedImage dst(src.size, std::move(src.data));
+
+    uint8_t* data = dst.data.get();
+    for (size_t i = 0; i < dst.bytes(); i += 4) {
+        const uint8_t a = data[i + 3];
+        data[i + 0] = (data[i + 0] * a + 127) / 255;
+        data[i + 1] = (data[i + 1] * a + 127) / 255;
+        data[i + 2] = (data[i + 2] * a + 127) / 255;
+    }
+
+    return dst;
+}
+
+UnassociatedImage unpremultiplyScalar(PremultipliedImage&& src) {
+    UnassociatedImage dst(src.size, std::move(src.data));
+
+    uint8_t* data = dst.data.get();
+    for (size_t i = 0; i < dst.bytes(); i += 4) {
+        const uint8_t a = data[i + 3];
+        if (a) {
+            data[i + 0] = (255 * data[i + 0] + (a / 2)) / a;
+            data[i + 1] = (255 * data[i + 1] + (a / 2)) / a;
+            data[i + 2] = (255 * data[i + 2] + (a / 2)) / a;
+        }
+    }
+
+    return dst;
+}
+
+// A 512px raster tile with partly transparent pixels.
+template <class ImageType>
+ImageType rasterTile() {
+    ImageType image({ 512, 512 });
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        image.data[i + 0] = i % 251;
+        image.data[i + 1] = i % 241;
+        image.data[i + 2] = i % 239;
+        image.data[i + 3] = std::max<std::size_t>(i % 256, i % 233);
+    }
+    return image;
+}
+
+} // end namespace
+
+static void Util_premultiply(::benchmark::State& state) {
+    const UnassociatedImage tile = rasterTile<UnassociatedImage>();
+    UnassociatedImage image = tile.clone();
+
+    while (state.KeepRunning()) {
+        if (state.range_x()) {
+            image = UnassociatedImage(image.size, util::premultiply(std::move(image)).data);
+        } else {
+            image = UnassociatedImage(image.size, premultiplyScalar(std::move(image)).data);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * tile.bytes());
+    state.SetLabel(state.range_x() ? "vector" : "scalar");
+}
+
+static void Util_unpremultiply(::benchmark::State& state) {
+    const PremultipliedImage tile = rasterTile<PremultipliedImage>();
+    PremultipliedImage image = tile.clone();
+
+    while (state.KeepRunning()) {
+        // Unpremultiplying the same pixels repeatedly would saturate them.
+        state.PauseTiming();
+        PremultipliedImage::copy(tile, image, { 0, 0 }, { 0, 0 }, tile.size);
+        state.ResumeTiming();
+
+        if (state.range_x()) {
+            image = PremultipliedImage(image.size, util::unpremultiply(std::move(image)).data);
+        } else {
+            image = PremultipliedImage(image.size, unpremultiplyScalar(std::move(image)).data);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * tile.bytes());
+    state.SetLabel(state.range_x() ? "vector" : "scalar");
+}
+
+// What the raster tile worker does with a tile: decode it, which premultiplies the pixels, and
+// unpremultiply it for the bucket.
+static void Util_decodeRasterTile(::benchmark::State& state) {
+    const std::string data = util::read_file("test/fixtures/image/tile.png");
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(util::unpremultiply(decodeImage(data)));
+    }
+}
+
+// Copies a tile into a wider image row by row, and into an image of the same width at once.
+static void Util_copyImage(::benchmark::State& state) {
+    const PremultipliedImage tile = rasterTile<PremultipliedImage>();
+    PremultipliedImage atlas({ state.range_x() ? tile.size.width : 2 * tile.size.width, tile.size.height });
+
+    while (state.KeepRunning()) {
+        PremultipliedImage::copy(tile, atlas, { 0, 0 }, { 0, 0 }, tile.size);
+    }
+
+    state.SetBytesProcessed(state.iterations() * tile.bytes());
+    state.SetLabel(state.range_x() ? "whole rows" : "row by row");
+}
+
+BENCHMARK(Util_premultiply)->Arg(0)->Arg(1);
+BENCHMARK(Util_unpremultiply)->Arg(0)->Arg(1);
+BENCHMARK(Util_decodeRasterTile);
+BENCHMARK(Util_copyImage)->Arg(0)->Arg(1);
@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using namespace mbgl;
+
+namespace {
+
+// The scheduler that `ThreadPool` used before it became work-stealing: every
+// worker takes mailboxes from one queue guarded by one mutex. Kept here as a
+// baseline for comparison.
+class SingleQueueThreadPool : public Scheduler {
+public:
+    SingleQueueThreadPool(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            threads.emplace_back([this]() {
+                while (true) {
+                    std::unique_lock<std::mutex> lock(mutex);
+
+                    cv.wait(lock, [this] {
+                        return !queue.empty() || terminate;
+                    });
+
+                    if (terminate) {
+                        return;
+                    }
+
+                    auto mailbox = queue.front();
+                    queue.pop();
+                    lock.unlock();
+
+                    Mailbox::maybeReceive(mailbox);
+                }
+            });
+        }
+    }
+
+    ~SingleQueueThreadPool() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            terminate = true;
+        }
+
+        cv.notify_all();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void schedule(std::weak_ptr<Mailbox> mailbox) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(mailbox);
+        }
+
+        cv.notify_one();
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::queue<std::weak_ptr<Mailbox>> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool terminate { false };
+};
+
+// Mimics a GeometryTileWorker: a short burst of messages per tile, each doing
+// a small amount of work, followed by a reply to the main thread.
+class TileWorker {
+public:
+    TileWorker(ActorRef<TileWorker>, std::atomic<std::size_t>& remaining_)
+        : remaining(remaining_) {
+    }
+
+    void layout(std::size_t work) {
+        volatile std::size_t sum = 0;
+        for (std::size_t i = 0; i < work; ++i) {
+            sum += i * i;
+        }
+        remaining--;
+    }
+
+private:
+    std::atomic<std::size_t>& remaining;
+};
+
+constexpr std::size_t tileCount = 256;
+constexpr std::size_t messagesPerTile = 4;
+
+template <class Pool>
+void Scheduler_TileBurst(::benchmark::State& state) {
+    Pool pool(state.range_x());
+    std::vector<std::unique_ptr<Actor<TileWorker>>> workers;
+    std::atomic<std::size_t> remaining { 0 };
+
+    for (std::size_t i = 0; i < tileCount; ++i) {
+        workers.emplace_back(std::make_unique<Actor<TileWorker>>(pool, remaining));
+    }
+
+    while (state.KeepRunning()) {
+        remaining = tileCount * messagesPerTile;
+
+        // Messages arrive from the main thread, interleaved across tiles, the
+        // way they do after a zoom invalidates every tile in the viewport.
+        for (std::size_t m = 0; m < messagesPerTile; ++m) {
+            for (auto& worker : workers) {
+                worker->invoke(&TileWorker::layout, std::size_t(2000));
+            }
+        }
+
+        while (remaining > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * tileCount * messagesPerTile);
+}
+
+template <class Pool>
+void Scheduler_LoadTiles(::benchmark::State& state) {
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ "benchmark/fixtures/api/cache.db", "." };
+    Pool pool(state.range_x());
+
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+    fileSource.setAccessToken("foobar");
+
+    const std::string style = util::read_file("benchmark/fixtures/api/query_style.json");
+
+    while (state.KeepRunning()) {
+        // A fresh map has an empty tile cache, so every render parses and lays
+        // out all visible tiles on the pool.
+        Map map{ backend, view.getSize(), 1, fileSource, pool, MapMode::Still };
+        map.setStyleJSON(style);
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+        mbgl::benchmark::render(map, view);
+    }
+}
+
+} // end namespace
+
+BENCHMARK_TEMPLATE(Scheduler_TileBurst, SingleQueueThreadPool)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK_TEMPLATE(Scheduler_TileBurst, ThreadPool)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK_TEMPLATE(Scheduler_LoadTiles, SingleQueueThreadPool)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK_TEMPLATE(Scheduler_LoadTiles, ThreadPool)->Arg(4)->Arg(16)->UseRealTime();
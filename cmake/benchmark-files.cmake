@@ -2,19 +2,38 @@
 
 set(MBGL_BENCHMARK_FILES
     # api
+    benchmark/api/geojson_update.benchmark.cpp
+    benchmark/api/overscale.benchmark.cpp
+    benchmark/api/parallel_layout.benchmark.cpp
     benchmark/api/query.benchmark.cpp
+    benchmark/api/rotate.benchmark.cpp
+    benchmark/api/shape_annotations.benchmark.cpp
 
     # include/mbgl
     benchmark/include/mbgl/benchmark.hpp
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/vector_tile.benchmark.cpp
 
     # src
     benchmark/src/main.cpp
 
     # src/mbgl/benchmark
+    benchmark/src/mbgl/benchmark/allocations.cpp
+    benchmark/src/mbgl/benchmark/allocations.hpp
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # storage
+    benchmark/storage/offline_database.benchmark.cpp
+
+    # text
+    benchmark/text/collision_tile.benchmark.cpp
+    benchmark/text/glyph_atlas.benchmark.cpp
+
+    # util
+    benchmark/util/premultiply.benchmark.cpp
+    benchmark/util/thread_pool.benchmark.cpp
 )
@@ -304,6 +304,8 @@ set(MBGL_CORE_FILES
     include/mbgl/style/conversion/source.hpp
     include/mbgl/style/conversion/tileset.hpp
     include/mbgl/style/conversion/transition_options.hpp
+    src/mbgl/style/conversion/geojson_reader.cpp
+    src/mbgl/style/conversion/geojson_reader.hpp
     src/mbgl/style/conversion/stringify.hpp
 
     # style/function
@@ -372,9 +374,13 @@ set(MBGL_CORE_FILES
     include/mbgl/style/sources/geojson_source.hpp
     include/mbgl/style/sources/raster_source.hpp
     include/mbgl/style/sources/vector_source.hpp
+    src/mbgl/style/sources/geojson_features.cpp
+    src/mbgl/style/sources/geojson_features.hpp
     src/mbgl/style/sources/geojson_source.cpp
     src/mbgl/style/sources/geojson_source_impl.cpp
     src/mbgl/style/sources/geojson_source_impl.hpp
+    src/mbgl/style/sources/geojson_source_worker.cpp
+    src/mbgl/style/sources/geojson_source_worker.hpp
     src/mbgl/style/sources/raster_source.cpp
     src/mbgl/style/sources/raster_source_impl.cpp
     src/mbgl/style/sources/raster_source_impl.hpp
@@ -417,6 +423,8 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/geometry_tile_data.hpp
     src/mbgl/tile/geometry_tile_worker.cpp
     src/mbgl/tile/geometry_tile_worker.hpp
+    src/mbgl/tile/layout_cache.cpp
+    src/mbgl/tile/layout_cache.hpp
     src/mbgl/tile/raster_tile.cpp
     src/mbgl/tile/raster_tile.hpp
     src/mbgl/tile/raster_tile_worker.cpp
@@ -432,6 +440,8 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/tile_observer.hpp
     src/mbgl/tile/vector_tile.cpp
     src/mbgl/tile/vector_tile.hpp
+    src/mbgl/tile/vector_tile_data.cpp
+    src/mbgl/tile/vector_tile_data.hpp
 
     # util
     include/mbgl/util/async_request.hpp
@@ -509,8 +519,12 @@ set(MBGL_CORE_FILES
     src/mbgl/util/mat4.cpp
     src/mbgl/util/mat4.hpp
     src/mbgl/util/math.hpp
+    src/mbgl/util/monotonic_arena.cpp
+    src/mbgl/util/monotonic_arena.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/parallel_for.cpp
+    src/mbgl/util/parallel_for.hpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/premultiply.hpp
     src/mbgl/util/rapidjson.hpp
@@ -21,6 +21,7 @@ set(MBGL_TEST_FILES
 
     # geometry
     test/geometry/binpack.test.cpp
+    test/geometry/feature_index.test.cpp
 
     # gl
     test/gl/bucket.test.cpp
@@ -71,11 +72,13 @@ set(MBGL_TEST_FILES
     test/storage/offline_download.test.cpp
     test/storage/online_file_source.test.cpp
     test/storage/resource.test.cpp
+    test/storage/response_cache.test.cpp
     test/storage/sqlite.test.cpp
 
     # style/conversion
     test/style/conversion/function.test.cpp
     test/style/conversion/geojson_options.test.cpp
+    test/style/conversion/geojson_reader.test.cpp
     test/style/conversion/layer.test.cpp
     test/style/conversion/stringify.test.cpp
 
@@ -87,6 +90,7 @@ set(MBGL_TEST_FILES
     test/style/function/source_function.test.cpp
 
     # style
+    test/style/geojson_features.test.cpp
     test/style/group_by_layout.test.cpp
     test/style/paint_property.test.cpp
     test/style/source.test.cpp
@@ -96,15 +100,19 @@ set(MBGL_TEST_FILES
     test/style/tile_source.test.cpp
 
     # text
+    test/text/collision_tile.test.cpp
     test/text/glyph_atlas.test.cpp
     test/text/glyph_pbf.test.cpp
+    test/text/placement_config.test.cpp
     test/text/quads.test.cpp
 
     # tile
     test/tile/annotation_tile.test.cpp
     test/tile/geojson_tile.test.cpp
     test/tile/geometry_tile_data.test.cpp
+    test/tile/layout_cache.test.cpp
     test/tile/raster_tile.test.cpp
+    test/tile/tile_cache.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
     test/tile/vector_tile.test.cpp
@@ -112,13 +120,17 @@ set(MBGL_TEST_FILES
     # util
     test/util/async_task.test.cpp
     test/util/geo.test.cpp
+    test/util/grid_index.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
+    test/util/io.test.cpp
     test/util/mapbox.test.cpp
     test/util/memory.test.cpp
     test/util/merge_lines.test.cpp
+    test/util/monotonic_arena.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/parallel_for.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
     test/util/text_conversions.test.cpp
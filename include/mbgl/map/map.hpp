@@ -191,6 +191,12 @@ public:
     void setSourceTileCacheSize(size_t);
     void onLowMemory();
 
+    // Performance
+    // Lays out the layer groups of a single tile on several threads of the scheduler at once,
+    // which shortens the time to the first frame when only few tiles load at the same time.
+    void setParallelTileLayout(bool);
+    bool getParallelTileLayout() const;
+
     // Debug
     void setDebug(MapDebugOptions);
     void cycleDebugOptions();
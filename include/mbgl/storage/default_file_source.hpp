@@ -39,6 +39,7 @@ public:
     void setResourceTransform(std::function<std::string(Resource::Kind, std::string&&)>);
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, uint32_t priority) override;
 
     /*
      * Retrieve all regions in the offline database.
@@ -115,6 +116,28 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Set the maximum size in bytes of the in-memory cache of recently requested resources,
+     * which is consulted before the database. Zero disables it.
+     */
+    void setMaximumMemoryCacheSize(uint64_t) const;
+
+    /*
+     * Set the interval to which the access times of cached resources, which decide what gets
+     * evicted first, are rounded down. Access times within an interval are kept in memory and
+     * written to the database together, which saves a write for most requests. Zero writes
+     * every access right away. Defaults to util::DEFAULT_ACCESS_TIME_GRANULARITY.
+     */
+    void setAccessTimeGranularity(Seconds) const;
+
+    /*
+     * Retrieve the number of requests served from the in-memory cache, and the number that
+     * had to look in the database. Useful for sizing the in-memory cache when several maps
+     * share a file source.
+     */
+    uint64_t getMemoryCacheHitCount() const;
+    uint64_t getMemoryCacheMissCount() const;
+
     /*
      * Pause file request activity.
      *
@@ -21,6 +21,7 @@ public:
     void setResourceTransform(ResourceTransform&& cb);
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, uint32_t priority) override;
 
 private:
     friend class OnlineFileRequest;
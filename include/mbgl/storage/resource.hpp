@@ -63,6 +63,10 @@ public:
     // Includes auxiliary data if this is a tile request.
     optional<TileData> tileData;
 
+    // Orders requests of the same kind and necessity while they wait for a connection. Lower
+    // values are served first, e.g. the distance of a tile from the center of the viewport.
+    uint32_t priority = 0;
+
     optional<Timestamp> priorModified = {};
     optional<Timestamp> priorExpires = {};
     optional<std::string> priorEtag = {};
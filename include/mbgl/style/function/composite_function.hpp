@@ -76,7 +76,7 @@ public:
     Range<T> evaluate(Range<InnerStops> coveringStops,
                       const GeometryTileFeature& feature,
                       T finalDefaultValue) const {
-        optional<Value> v = feature.getValue(property);
+        const auto v = feature.lookupValue(property);
         if (!v) {
             return {
                 defaultValue.value_or(finalDefaultValue),
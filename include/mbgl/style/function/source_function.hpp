@@ -35,7 +35,7 @@ public:
     }
 
     T evaluate(const GeometryTileFeature& feature, T finalDefaultValue) const {
-        optional<Value> v = feature.getValue(property);
+        const auto v = feature.lookupValue(property);
         if (!v) {
             return defaultValue.value_or(finalDefaultValue);
         }
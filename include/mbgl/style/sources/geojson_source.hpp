@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/source.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -43,6 +44,13 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
 
+    // Adds the given features, replacing existing features with the same identifier.
+    // Unlike setGeoJSON, only tiles that contain changed features are updated.
+    void upsertFeatures(const FeatureCollection&);
+
+    // Removes the features with the given identifiers.
+    void removeFeatures(const std::vector<FeatureIdentifier>&);
+
     optional<std::string> getURL() const;
 
     // Private implementation
@@ -39,6 +39,8 @@ constexpr float  MIN_ZOOM_F = MIN_ZOOM;
 constexpr float  MAX_ZOOM_F = MAX_ZOOM;
 
 constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
+constexpr uint64_t DEFAULT_MAX_MEMORY_CACHE_SIZE = 4 * 1024 * 1024;
+constexpr Seconds DEFAULT_ACCESS_TIME_GRANULARITY { 60 };
 
 constexpr Duration DEFAULT_FADE_DURATION = Milliseconds(300);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT { 30 };
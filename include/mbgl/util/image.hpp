@@ -106,6 +106,14 @@ public:
 
         assert(srcData != dstData);
 
+        // Rows that span both images are contiguous, so they are copied at once.
+        if (size.width == srcImg.size.width && size.width == dstImg.size.width) {
+            std::copy(srcData + srcPt.y * srcImg.stride(),
+                      srcData + (srcPt.y + size.height) * srcImg.stride(),
+                      dstData + dstPt.y * dstImg.stride());
+            return;
+        }
+
         for (uint32_t y = 0; y < size.height; y++) {
             const std::size_t srcOffset = (srcPt.y + y) * srcImg.stride() + srcPt.x * channels;
             const std::size_t dstOffset = (dstPt.y + y) * dstImg.stride() + dstPt.x * channels;
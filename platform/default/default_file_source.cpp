@@ -4,12 +4,14 @@
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
+#include <mbgl/storage/response_cache.hpp>
 
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/work_request.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace {
@@ -24,10 +26,32 @@ bool isAssetURL(const std::string& url) {
 
 namespace mbgl {
 
+// Looks up resources in the offline database on a thread of its own, so that several lookups
+// can use the database's read-only connections at once.
+class CacheReader {
+public:
+    CacheReader(OfflineDatabase& offlineDatabase_)
+        : offlineDatabase(offlineDatabase_) {
+    }
+
+    void get(const Resource& resource, std::function<void (optional<Response>)> callback) {
+        callback(offlineDatabase.get(resource));
+    }
+
+private:
+    OfflineDatabase& offlineDatabase;
+};
+
 class DefaultFileSource::Impl {
 public:
     Impl(const std::string& cachePath, uint64_t maximumCacheSize)
-        : offlineDatabase(cachePath, maximumCacheSize) {
+        : offlineDatabase(cachePath, maximumCacheSize),
+          memoryCache(util::DEFAULT_MAX_MEMORY_CACHE_SIZE) {
+        const std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < threadCount && i < OfflineDatabase::maximumReaderCount; i++) {
+            readers.push_back(std::make_unique<util::Thread<CacheReader>>(
+                util::ThreadContext{"CacheReader", util::ThreadPriority::Low}, offlineDatabase));
+        }
     }
 
     void setAPIBaseURL(const std::string& url) {
@@ -105,50 +129,112 @@ public:
     }
 
     void request(AsyncRequest* req, Resource resource, Callback callback) {
-        Resource revalidation = resource;
-
         const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
-        if (!hasPrior || resource.necessity == Resource::Optional) {
-            auto offlineResponse = offlineDatabase.get(resource);
-
-            if (resource.necessity == Resource::Optional && !offlineResponse) {
-                // Ensure there's always a response that we can send, so the caller knows that
-                // there's no optional data available in the cache.
-                offlineResponse.emplace();
-                offlineResponse->noContent = true;
-                offlineResponse->error = std::make_unique<Response::Error>(
-                    Response::Error::Reason::NotFound, "Not found in offline database");
-            }
-
-            if (offlineResponse) {
-                revalidation.priorModified = offlineResponse->modified;
-                revalidation.priorExpires = offlineResponse->expires;
-                revalidation.priorEtag = offlineResponse->etag;
-                callback(*offlineResponse);
-            }
+        if (hasPrior && resource.necessity == Resource::Required) {
+            requestOnline(req, resource, callback);
+            return;
         }
 
-        if (resource.necessity == Resource::Required) {
-            tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
-                this->offlineDatabase.put(revalidation, onlineResponse);
-                callback(onlineResponse);
-            });
+        if (auto cachedResponse = memoryCache.get(resource)) {
+            offlineDatabase.markAccessed(resource);
+            respond(req, resource, std::move(cachedResponse), callback);
+            return;
         }
+
+        // The lookup runs on one of the reader threads, and the request continues on this thread
+        // once it is done. Cancelling the request cancels the lookup as well.
+        auto& reader = *readers[nextReader++ % readers.size()];
+        tasks[req] = reader.invokeWithCallback(&CacheReader::get, resource,
+            [this, req, resource, callback] (optional<Response> offlineResponse) {
+                if (offlineResponse) {
+                    memoryCache.put(resource, *offlineResponse);
+                }
+                respond(req, resource, std::move(offlineResponse), callback);
+            });
     }
 
     void cancel(AsyncRequest* req) {
         tasks.erase(req);
+        priorities.erase(req);
+    }
+
+    // Lookups in the database aren't queued, so a priority set while one is running is kept
+    // and applied once the request goes online.
+    void setPriority(AsyncRequest* req, uint32_t priority) {
+        auto it = tasks.find(req);
+        if (it == tasks.end()) {
+            return;
+        }
+        priorities[req] = priority;
+        onlineFileSource.setPriority(*it->second, priority);
     }
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
+    void setMaximumMemoryCacheSize(uint64_t size) {
+        memoryCache.setMaximumSize(size);
+    }
+
+    void setAccessTimeGranularity(Seconds granularity) {
+        offlineDatabase.setAccessTimeGranularity(granularity);
+    }
+
+    uint64_t getMemoryCacheHitCount() {
+        return memoryCache.getHitCount();
+    }
+
+    uint64_t getMemoryCacheMissCount() {
+        return memoryCache.getMissCount();
+    }
+
     void put(const Resource& resource, const Response& response) {
         offlineDatabase.put(resource, response);
+        memoryCache.put(resource, response);
     }
 
 private:
+    // Continues a request with the response found in the memory cache or the database, if any.
+    void respond(AsyncRequest* req, const Resource& resource, optional<Response> offlineResponse, Callback callback) {
+        Resource revalidation = resource;
+
+        if (resource.necessity == Resource::Optional && !offlineResponse) {
+            // Ensure there's always a response that we can send, so the caller knows that
+            // there's no optional data available in the cache.
+            offlineResponse.emplace();
+            offlineResponse->noContent = true;
+            offlineResponse->error = std::make_unique<Response::Error>(
+                Response::Error::Reason::NotFound, "Not found in offline database");
+        }
+
+        if (offlineResponse) {
+            revalidation.priorModified = offlineResponse->modified;
+            revalidation.priorExpires = offlineResponse->expires;
+            revalidation.priorEtag = offlineResponse->etag;
+            callback(*offlineResponse);
+        }
+
+        if (resource.necessity == Resource::Required) {
+            requestOnline(req, revalidation, callback);
+        } else {
+            tasks.erase(req);
+            priorities.erase(req);
+        }
+    }
+
+    void requestOnline(AsyncRequest* req, Resource revalidation, Callback callback) {
+        auto it = priorities.find(req);
+        if (it != priorities.end()) {
+            revalidation.priority = it->second;
+        }
+        tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
+            this->offlineDatabase.put(revalidation, onlineResponse);
+            this->memoryCache.put(revalidation, onlineResponse);
+            callback(onlineResponse);
+        });
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -160,7 +246,11 @@ private:
 
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
+    ResponseCache memoryCache;
+    std::vector<std::unique_ptr<util::Thread<CacheReader>>> readers;
+    std::size_t nextReader = 0;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
+    std::unordered_map<AsyncRequest*, uint32_t> priorities;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
 };
 
@@ -227,6 +317,10 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
     }
 }
 
+void DefaultFileSource::setPriority(AsyncRequest& req, uint32_t priority) {
+    thread->invoke(&Impl::setPriority, &req, priority);
+}
+
 void DefaultFileSource::listOfflineRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
     thread->invoke(&Impl::listRegions, callback);
 }
@@ -263,6 +357,22 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     thread->invokeSync(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::setMaximumMemoryCacheSize(uint64_t size) const {
+    thread->invokeSync(&Impl::setMaximumMemoryCacheSize, size);
+}
+
+void DefaultFileSource::setAccessTimeGranularity(Seconds granularity) const {
+    thread->invokeSync(&Impl::setAccessTimeGranularity, granularity);
+}
+
+uint64_t DefaultFileSource::getMemoryCacheHitCount() const {
+    return thread->invokeSync(&Impl::getMemoryCacheHitCount);
+}
+
+uint64_t DefaultFileSource::getMemoryCacheMissCount() const {
+    return thread->invokeSync(&Impl::getMemoryCacheMissCount);
+}
+
 void DefaultFileSource::pause() {
     thread->pause();
 }
@@ -19,23 +19,28 @@ OfflineDatabase::OfflineDatabase(std::string path_, uint64_t maximumCacheSize_)
     : path(std::move(path_)),
       maximumCacheSize(maximumCacheSize_) {
     ensureSchema();
+
+    // Unlike the journal mode, this setting only lasts as long as the connection.
+    writer.db->exec("PRAGMA synchronous = NORMAL");
 }
 
 OfflineDatabase::~OfflineDatabase() {
     // Deleting these SQLite objects may result in exceptions, but we're in a destructor, so we
     // can't throw anything.
     try {
-        statements.clear();
-        db.reset();
+        flushAccessed();
+        idleReaders.clear();
+        writer.statements.clear();
+        writer.db.reset();
     } catch (mapbox::sqlite::Exception& ex) {
         Log::Error(Event::Database, ex.code, ex.what());
     }
 }
 
 void OfflineDatabase::connect(int flags) {
-    db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), flags);
-    db->setBusyTimeout(Milliseconds::max());
-    db->exec("PRAGMA foreign_keys = ON");
+    writer.db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), flags);
+    writer.db->setBusyTimeout(Milliseconds::max());
+    writer.db->exec("PRAGMA foreign_keys = ON");
 }
 
 void OfflineDatabase::ensureSchema() {
@@ -49,7 +54,8 @@ void OfflineDatabase::ensureSchema() {
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 5: migrateToVersion6(); // fall through
+            case 6: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -79,11 +85,11 @@ void OfflineDatabase::ensureSchema() {
         connect(mapbox::sqlite::ReadWrite | mapbox::sqlite::Create);
 
         // If you change the schema you must write a migration from the previous version.
-        db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-        db->exec("PRAGMA journal_mode = DELETE");
-        db->exec("PRAGMA synchronous = FULL");
-        db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        writer.db->exec("PRAGMA auto_vacuum = INCREMENTAL");
+        writer.db->exec("PRAGMA journal_mode = WAL");
+        writer.db->exec("PRAGMA synchronous = NORMAL");
+        writer.db->exec(schema);
+        writer.db->exec("PRAGMA user_version = 6");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -91,7 +97,7 @@ void OfflineDatabase::ensureSchema() {
 }
 
 int OfflineDatabase::userVersion() {
-    auto stmt = db->prepare("PRAGMA user_version");
+    auto stmt = writer.db->prepare("PRAGMA user_version");
     stmt.run();
     return stmt.get<int>(0);
 }
@@ -99,7 +105,7 @@ int OfflineDatabase::userVersion() {
 void OfflineDatabase::removeExisting() {
     Log::Warning(Event::Database, "Removing existing incompatible offline database");
 
-    db.reset();
+    writer.db.reset();
 
     try {
         util::deleteFile(path);
@@ -109,9 +115,9 @@ void OfflineDatabase::removeExisting() {
 }
 
 void OfflineDatabase::migrateToVersion3() {
-    db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-    db->exec("VACUUM");
-    db->exec("PRAGMA user_version = 3");
+    writer.db->exec("PRAGMA auto_vacuum = INCREMENTAL");
+    writer.db->exec("VACUUM");
+    writer.db->exec("PRAGMA user_version = 3");
 }
 
 // Schema version 4 was WAL journal + NORMAL sync. It was reverted during pre-
@@ -121,12 +127,21 @@ void OfflineDatabase::migrateToVersion3() {
 // See: https://github.com/mapbox/mapbox-gl-native/pull/6320
 
 void OfflineDatabase::migrateToVersion5() {
-    db->exec("PRAGMA journal_mode = DELETE");
-    db->exec("PRAGMA synchronous = FULL");
-    db->exec("PRAGMA user_version = 5");
+    writer.db->exec("PRAGMA journal_mode = DELETE");
+    writer.db->exec("PRAGMA synchronous = FULL");
+    writer.db->exec("PRAGMA user_version = 5");
 }
 
-OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
+// Schema version 6 returns to WAL journal + NORMAL sync, so that read-only connections can
+// look up resources while the writer connection stores others.
+
+void OfflineDatabase::migrateToVersion6() {
+    writer.db->exec("PRAGMA journal_mode = WAL");
+    writer.db->exec("PRAGMA synchronous = NORMAL");
+    writer.db->exec("PRAGMA user_version = 6");
+}
+
+OfflineDatabase::Statement OfflineDatabase::Connection::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
     if (it != statements.end()) {
@@ -136,30 +151,152 @@ OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     return Statement(*statements.emplace(sql, std::make_unique<mapbox::sqlite::Statement>(db->prepare(sql))).first->second);
 }
 
+OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
+    return writer.getStatement(sql);
+}
+
+template <class Fn>
+auto OfflineDatabase::read(Fn&& fn) {
+    if (path == ":memory:") {
+        std::lock_guard<std::mutex> lock(mutex);
+        return fn(writer);
+    }
+
+    std::unique_ptr<Connection> reader;
+    {
+        std::unique_lock<std::mutex> lock(readersMutex);
+        readerReleased.wait(lock, [&] { return !idleReaders.empty() || readerCount < maximumReaderCount; });
+        if (!idleReaders.empty()) {
+            reader = std::move(idleReaders.back());
+            idleReaders.pop_back();
+        } else {
+            readerCount++;
+        }
+    }
+
+    // Returns the reader to the pool, or gives up its slot if it couldn't be opened.
+    auto release = [&] {
+        {
+            std::lock_guard<std::mutex> lock(readersMutex);
+            if (reader) {
+                idleReaders.push_back(std::move(reader));
+            } else {
+                readerCount--;
+            }
+        }
+        readerReleased.notify_one();
+    };
+
+    try {
+        if (!reader) {
+            auto connection = std::make_unique<Connection>();
+            connection->db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), mapbox::sqlite::ReadOnly);
+            connection->db->setBusyTimeout(Milliseconds::max());
+            reader = std::move(connection);
+        }
+        auto result = fn(*reader);
+        release();
+        return result;
+    } catch (...) {
+        // Close a connection that failed, in case it is in a bad state.
+        reader.reset();
+        release();
+        throw;
+    }
+}
+
 optional<Response> OfflineDatabase::get(const Resource& resource) {
-    auto result = getInternal(resource);
-    return result ? result->first : optional<Response>();
+    auto result = read([&] (Connection& connection) {
+        return getInternal(connection, resource);
+    });
+
+    if (!result) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    updateAccessed(resource);
+    return result->first;
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
+void OfflineDatabase::markAccessed(const Resource& resource) {
+    std::lock_guard<std::mutex> lock(mutex);
+    updateAccessed(resource);
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(Connection& connection, const Resource& resource) {
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        return getTile(connection, *resource.tileData);
+    } else {
+        return getResource(connection, resource);
+    }
+}
+
+optional<int64_t> OfflineDatabase::hasInternal(Connection& connection, const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        return getTile(*resource.tileData);
+        return hasTile(connection, *resource.tileData);
     } else {
-        return getResource(resource);
+        return hasResource(connection, resource);
     }
 }
 
-optional<int64_t> OfflineDatabase::hasInternal(const Resource& resource) {
+void OfflineDatabase::updateAccessed(const Resource& resource) {
+    Timestamp now = util::now();
+    if (accessTimeGranularity > Seconds::zero()) {
+        now -= now.time_since_epoch() % accessTimeGranularity;
+    }
+
+    if (now != accessedTime) {
+        flushAccessed();
+        accessedTime = now;
+    }
+
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        return hasTile(*resource.tileData);
+        const Resource::TileData& tile = *resource.tileData;
+        accessedTiles.emplace(tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z);
     } else {
-        return hasResource(resource);
+        accessedResources.emplace(resource.url);
+    }
+
+    if (accessTimeGranularity == Seconds::zero() ||
+        accessedTiles.size() + accessedResources.size() >= maximumAccessedCount) {
+        flushAccessed();
+    }
+}
+
+void OfflineDatabase::flushAccessed() {
+    if (accessedTiles.empty() && accessedResources.empty()) {
+        return;
+    }
+
+    mapbox::sqlite::Transaction transaction(*writer.db, mapbox::sqlite::Transaction::Immediate);
+
+    for (const auto& tile : accessedTiles) {
+        updateTileAccessed({ std::get<0>(tile), std::get<1>(tile), std::get<2>(tile),
+                             std::get<3>(tile), std::get<4>(tile) }, accessedTime);
     }
+
+    for (const auto& url : accessedResources) {
+        updateResourceAccessed(url, accessedTime);
+    }
+
+    transaction.commit();
+
+    accessedTiles.clear();
+    accessedResources.clear();
+}
+
+void OfflineDatabase::setAccessTimeGranularity(Seconds granularity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushAccessed();
+    accessTimeGranularity = granularity;
 }
 
 std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const Response& response) {
+    std::lock_guard<std::mutex> lock(mutex);
     return putInternal(resource, response, true);
 }
 
@@ -185,32 +322,27 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
 
     bool inserted;
 
+    // Puts write the current time as the access time, so a buffered one is stale.
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData, response,
+        const Resource::TileData& tile = *resource.tileData;
+        inserted = putTile(tile, response,
                 compressed ? compressedData : *response.data,
                 compressed);
+        accessedTiles.erase(std::make_tuple(tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z));
     } else {
         inserted = putResource(resource, response,
                 compressed ? compressedData : *response.data,
                 compressed);
+        accessedResources.erase(resource.url);
     }
 
     return { inserted, size };
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
-    // clang-format off
-    Statement accessedStmt = getStatement(
-        "UPDATE resources SET accessed = ?1 WHERE url = ?2");
-    // clang-format on
-
-    accessedStmt->bind(1, util::now());
-    accessedStmt->bind(2, resource.url);
-    accessedStmt->run();
-
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(Connection& connection, const Resource& resource) {
     // clang-format off
-    Statement stmt = getStatement(
+    Statement stmt = connection.getStatement(
         //        0      1        2       3        4
         "SELECT etag, expires, modified, data, compressed "
         "FROM resources "
@@ -244,9 +376,20 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     return std::make_pair(response, size);
 }
 
-optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
+void OfflineDatabase::updateResourceAccessed(const std::string& url, Timestamp accessed) {
+    // clang-format off
+    Statement accessedStmt = getStatement(
+        "UPDATE resources SET accessed = max(accessed, ?1) WHERE url = ?2");
+    // clang-format on
+
+    accessedStmt->bind(1, accessed);
+    accessedStmt->bind(2, url);
+    accessedStmt->run();
+}
+
+optional<int64_t> OfflineDatabase::hasResource(Connection& connection, const Resource& resource) {
     // clang-format off
-    Statement stmt = getStatement("SELECT length(data) FROM resources WHERE url = ?");
+    Statement stmt = connection.getStatement("SELECT length(data) FROM resources WHERE url = ?");
     // clang-format on
 
     stmt->bind(1, resource.url);
@@ -281,7 +424,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
     // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    mapbox::sqlite::Transaction transaction(*writer.db, mapbox::sqlite::Transaction::Immediate);
 
     // clang-format off
     Statement update = getStatement(
@@ -344,28 +487,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
     return true;
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(Connection& connection, const Resource::TileData& tile) {
     // clang-format off
-    Statement accessedStmt = getStatement(
-        "UPDATE tiles "
-        "SET accessed       = ?1 "
-        "WHERE url_template = ?2 "
-        "  AND pixel_ratio  = ?3 "
-        "  AND x            = ?4 "
-        "  AND y            = ?5 "
-        "  AND z            = ?6 ");
-    // clang-format on
-
-    accessedStmt->bind(1, util::now());
-    accessedStmt->bind(2, tile.urlTemplate);
-    accessedStmt->bind(3, tile.pixelRatio);
-    accessedStmt->bind(4, tile.x);
-    accessedStmt->bind(5, tile.y);
-    accessedStmt->bind(6, tile.z);
-    accessedStmt->run();
-
-    // clang-format off
-    Statement stmt = getStatement(
+    Statement stmt = connection.getStatement(
         //        0      1        2       3        4
         "SELECT etag, expires, modified, data, compressed "
         "FROM tiles "
@@ -407,9 +531,30 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     return std::make_pair(response, size);
 }
 
-optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
+void OfflineDatabase::updateTileAccessed(const Resource::TileData& tile, Timestamp accessed) {
     // clang-format off
-    Statement stmt = getStatement(
+    Statement accessedStmt = getStatement(
+        "UPDATE tiles "
+        "SET accessed       = max(accessed, ?1) "
+        "WHERE url_template = ?2 "
+        "  AND pixel_ratio  = ?3 "
+        "  AND x            = ?4 "
+        "  AND y            = ?5 "
+        "  AND z            = ?6 ");
+    // clang-format on
+
+    accessedStmt->bind(1, accessed);
+    accessedStmt->bind(2, tile.urlTemplate);
+    accessedStmt->bind(3, tile.pixelRatio);
+    accessedStmt->bind(4, tile.x);
+    accessedStmt->bind(5, tile.y);
+    accessedStmt->bind(6, tile.z);
+    accessedStmt->run();
+}
+
+optional<int64_t> OfflineDatabase::hasTile(Connection& connection, const Resource::TileData& tile) {
+    // clang-format off
+    Statement stmt = connection.getStatement(
         "SELECT length(data) "
         "FROM tiles "
         "WHERE url_template = ?1 "
@@ -464,7 +609,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
     // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    mapbox::sqlite::Transaction transaction(*writer.db, mapbox::sqlite::Transaction::Immediate);
 
     // clang-format off
     Statement update = getStatement(
@@ -537,6 +682,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 }
 
 std::vector<OfflineRegion> OfflineDatabase::listRegions() {
+    std::lock_guard<std::mutex> lock(mutex);
     // clang-format off
     Statement stmt = getStatement(
         "SELECT id, definition, description FROM regions");
@@ -556,6 +702,7 @@ std::vector<OfflineRegion> OfflineDatabase::listRegions() {
 
 OfflineRegion OfflineDatabase::createRegion(const OfflineRegionDefinition& definition,
                                             const OfflineRegionMetadata& metadata) {
+    std::lock_guard<std::mutex> lock(mutex);
     // clang-format off
     Statement stmt = getStatement(
         "INSERT INTO regions (definition, description) "
@@ -570,6 +717,7 @@ OfflineRegion OfflineDatabase::createRegion(const OfflineRegionDefinition& defin
 }
 
 OfflineRegionMetadata OfflineDatabase::updateMetadata(const int64_t regionID, const OfflineRegionMetadata& metadata) {
+    std::lock_guard<std::mutex> lock(mutex);
     // clang-format off
     Statement stmt = getStatement(
                                   "UPDATE regions SET description = ?1"
@@ -583,6 +731,7 @@ OfflineRegionMetadata OfflineDatabase::updateMetadata(const int64_t regionID, co
 }
 
 void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
+    std::lock_guard<std::mutex> lock(mutex);
     // clang-format off
     Statement stmt = getStatement(
         "DELETE FROM regions WHERE id = ?");
@@ -592,16 +741,18 @@ void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
     stmt->run();
 
     evict(0);
-    db->exec("PRAGMA incremental_vacuum");
+    writer.db->exec("PRAGMA incremental_vacuum");
 
     // Ensure that the cached offlineTileCount value is recalculated.
     offlineMapboxTileCount = {};
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64_t regionID, const Resource& resource) {
-    auto response = getInternal(resource);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto response = getInternal(writer, resource);
 
     if (response) {
+        updateAccessed(resource);
         markUsed(regionID, resource);
     }
 
@@ -609,9 +760,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64
 }
 
 optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Resource& resource) {
-    auto response = hasInternal(resource);
+    auto response = read([&] (Connection& connection) {
+        return hasInternal(connection, resource);
+    });
 
     if (response) {
+        std::lock_guard<std::mutex> lock(mutex);
         markUsed(regionID, resource);
     }
 
@@ -619,6 +773,7 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
 }
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
+    std::lock_guard<std::mutex> lock(mutex);
     uint64_t size = putInternal(resource, response, false).second;
     bool previouslyUnused = markUsed(regionID, resource);
 
@@ -712,6 +867,7 @@ bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
 }
 
 OfflineRegionDefinition OfflineDatabase::getRegionDefinition(int64_t regionID) {
+    std::lock_guard<std::mutex> lock(mutex);
     // clang-format off
     Statement stmt = getStatement(
         "SELECT definition FROM regions WHERE id = ?1");
@@ -724,6 +880,7 @@ OfflineRegionDefinition OfflineDatabase::getRegionDefinition(int64_t regionID) {
 }
 
 OfflineRegionStatus OfflineDatabase::getRegionCompletedStatus(int64_t regionID) {
+    std::lock_guard<std::mutex> lock(mutex);
     OfflineRegionStatus result;
 
     std::tie(result.completedResourceCount, result.completedResourceSize)
@@ -791,6 +948,10 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
     // The addition of pageSize is a fudge factor to account for non `data` column
     // size, and because pages can get fragmented on the database.
     while (usedSize() + neededFreeSize + pageSize > maximumCacheSize) {
+        // Eviction picks the least recently accessed resources, so the buffered access times
+        // need to be in the database first.
+        flushAccessed();
+
         // clang-format off
         Statement accessedStmt = getStatement(
             "SELECT max(accessed) "
@@ -858,18 +1019,26 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
 }
 
 void OfflineDatabase::setOfflineMapboxTileCountLimit(uint64_t limit) {
+    std::lock_guard<std::mutex> lock(mutex);
     offlineMapboxTileCountLimit = limit;
 }
 
 uint64_t OfflineDatabase::getOfflineMapboxTileCountLimit() {
+    std::lock_guard<std::mutex> lock(mutex);
     return offlineMapboxTileCountLimit;
 }
 
 bool OfflineDatabase::offlineMapboxTileCountLimitExceeded() {
-    return getOfflineMapboxTileCount() >= offlineMapboxTileCountLimit;
+    std::lock_guard<std::mutex> lock(mutex);
+    return getOfflineMapboxTileCountInternal() >= offlineMapboxTileCountLimit;
 }
 
 uint64_t OfflineDatabase::getOfflineMapboxTileCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return getOfflineMapboxTileCountInternal();
+}
+
+uint64_t OfflineDatabase::getOfflineMapboxTileCountInternal() {
     // Calculating this on every call would be much simpler than caching and
     // manually updating the value, but it would make offline downloads an O(n²)
     // operation, because the database query below involves an index scan of
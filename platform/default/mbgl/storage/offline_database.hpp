@@ -7,9 +7,15 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
 
+#include <condition_variable>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -23,6 +29,10 @@ namespace mbgl {
 class Response;
 class TileID;
 
+// All methods may be called from any thread. Writes go through a single connection, one at a
+// time. Lookups with get() and hasRegionResource() use a pool of read-only connections, so
+// they run in parallel with each other and with writes, which the database's write-ahead log
+// permits. In-memory databases do everything on the writer connection.
 class OfflineDatabase : private util::noncopyable {
 public:
     // Limits affect ambient caching (put) only; resources required by offline
@@ -30,8 +40,15 @@ public:
     OfflineDatabase(std::string path, uint64_t maximumCacheSize = util::DEFAULT_MAX_CACHE_SIZE);
     ~OfflineDatabase();
 
+    // The number of read-only connections the database opens at most.
+    static constexpr std::size_t maximumReaderCount = 4;
+
     optional<Response> get(const Resource&);
 
+    // Records an access to a resource that was served without looking it up here, so that it
+    // isn't evicted as unused.
+    void markAccessed(const Resource&);
+
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
@@ -57,6 +74,14 @@ public:
     bool offlineMapboxTileCountLimitExceeded();
     uint64_t getOfflineMapboxTileCount();
 
+    // Access times of cached resources, which decide what gets evicted first, are rounded down
+    // to a multiple of this interval. They are kept in memory and written together with the
+    // first access in a later interval, once 1024 of them are kept, before evicting, and when
+    // the database is closed; there is no timer, so an idle database holds on to them. Puts
+    // write the access time of what they store themselves. With an interval of zero, every
+    // access is written right away.
+    void setAccessTimeGranularity(Seconds);
+
 private:
     void connect(int flags);
     int userVersion();
@@ -64,6 +89,7 @@ private:
     void removeExisting();
     void migrateToVersion3();
     void migrateToVersion5();
+    void migrateToVersion6();
 
     class Statement {
     public:
@@ -78,20 +104,40 @@ private:
         mapbox::sqlite::Statement& stmt;
     };
 
+    // A connection along with the statements prepared on it.
+    class Connection {
+    public:
+        Statement getStatement(const char *);
+
+        std::unique_ptr<::mapbox::sqlite::Database> db;
+        std::unordered_map<const char *, std::unique_ptr<::mapbox::sqlite::Statement>> statements;
+    };
+
+    // Prepares a statement on the writer connection.
     Statement getStatement(const char *);
 
-    optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
-    optional<int64_t> hasTile(const Resource::TileData&);
+    // Calls the function with an idle reader connection, opening one if there is none and
+    // fewer than maximumReaderCount are open, or waiting for one otherwise. In-memory
+    // databases can't be opened twice, so the function gets the writer connection instead.
+    template <class Fn>
+    auto read(Fn&&);
+
+    optional<std::pair<Response, uint64_t>> getTile(Connection&, const Resource::TileData&);
+    optional<int64_t> hasTile(Connection&, const Resource::TileData&);
+    void updateTileAccessed(const Resource::TileData&, Timestamp);
     bool putTile(const Resource::TileData&, const Response&,
                  const std::string&, bool compressed);
 
-    optional<std::pair<Response, uint64_t>> getResource(const Resource&);
-    optional<int64_t> hasResource(const Resource&);
+    optional<std::pair<Response, uint64_t>> getResource(Connection&, const Resource&);
+    optional<int64_t> hasResource(Connection&, const Resource&);
+    void updateResourceAccessed(const std::string& url, Timestamp);
     bool putResource(const Resource&, const Response&,
                      const std::string&, bool compressed);
 
-    optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
-    optional<int64_t> hasInternal(const Resource&);
+    optional<std::pair<Response, uint64_t>> getInternal(Connection&, const Resource&);
+    optional<int64_t> hasInternal(Connection&, const Resource&);
+    void updateAccessed(const Resource&);
+    void flushAccessed();
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
 
     // Return value is true iff the resource was previously unused by any other regions.
@@ -100,9 +146,13 @@ private:
     std::pair<int64_t, int64_t> getCompletedResourceCountAndSize(int64_t regionID);
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
 
+    uint64_t getOfflineMapboxTileCountInternal();
+
     const std::string path;
-    std::unique_ptr<::mapbox::sqlite::Database> db;
-    std::unordered_map<const char *, std::unique_ptr<::mapbox::sqlite::Statement>> statements;
+
+    // Guards the writer connection and the state below it.
+    std::mutex mutex;
+    Connection writer;
 
     template <class T>
     T getPragma(const char *);
@@ -113,6 +163,18 @@ private:
     optional<uint64_t> offlineMapboxTileCount;
 
     bool evict(uint64_t neededFreeSize);
+
+    // The tiles and resources accessed since the last flush, all at accessedTime.
+    static constexpr std::size_t maximumAccessedCount = 1024;
+    Seconds accessTimeGranularity = util::DEFAULT_ACCESS_TIME_GRANULARITY;
+    Timestamp accessedTime;
+    std::set<std::tuple<std::string, uint8_t, int32_t, int32_t, int8_t>> accessedTiles;
+    std::unordered_set<std::string> accessedResources;
+
+    std::mutex readersMutex;
+    std::condition_variable readerReleased;
+    std::vector<std::unique_ptr<Connection>> idleReaders;
+    std::size_t readerCount = 0;
 };
 
 } // namespace mbgl
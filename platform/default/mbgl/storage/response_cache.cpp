@@ -0,0 +1,90 @@
+#include <mbgl/storage/response_cache.hpp>
+
+#include <cassert>
+#include <iterator>
+
+namespace mbgl {
+
+ResponseCache::ResponseCache(uint64_t maximumSize_)
+    : maximumSize(maximumSize_) {
+}
+
+ResponseCache::Key ResponseCache::makeKey(const Resource& resource) {
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        const Resource::TileData& tile = *resource.tileData;
+        return Key { tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z };
+    } else {
+        return Key { resource.url, 0, 0, 0, 0 };
+    }
+}
+
+optional<Response> ResponseCache::get(const Resource& resource) {
+    auto it = index.find(makeKey(resource));
+    if (it == index.end()) {
+        missCount++;
+        return {};
+    }
+
+    hitCount++;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->response;
+}
+
+void ResponseCache::put(const Resource& resource, const Response& response) {
+    if (response.error) {
+        return;
+    }
+
+    Key key = makeKey(resource);
+    auto it = index.find(key);
+
+    if (response.notModified) {
+        if (it != index.end()) {
+            it->second->response.expires = response.expires;
+            entries.splice(entries.begin(), entries, it->second);
+        }
+        return;
+    }
+
+    if (it != index.end()) {
+        erase(it->second);
+    }
+
+    const uint64_t entrySize = std::get<0>(key).size() + (response.data ? response.data->size() : 0);
+    if (entrySize > maximumSize) {
+        return;
+    }
+
+    entries.push_front({ key, response, entrySize });
+    index.emplace(std::move(key), entries.begin());
+    size += entrySize;
+
+    evict();
+}
+
+void ResponseCache::setMaximumSize(uint64_t maximumSize_) {
+    maximumSize = maximumSize_;
+    evict();
+}
+
+void ResponseCache::clear() {
+    entries.clear();
+    index.clear();
+    size = 0;
+}
+
+void ResponseCache::erase(std::list<Entry>::iterator it) {
+    size -= it->size;
+    index.erase(it->key);
+    entries.erase(it);
+}
+
+void ResponseCache::evict() {
+    while (size > maximumSize) {
+        assert(!entries.empty());
+        erase(std::prev(entries.end()));
+    }
+}
+
+} // namespace mbgl
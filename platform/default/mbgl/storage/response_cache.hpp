@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace mbgl {
+
+// Keeps the most recently used responses in memory, up to a total size in bytes. The responses
+// it returns share their data with the stored ones, so a hit neither decompresses nor copies it.
+class ResponseCache : private util::noncopyable {
+public:
+    ResponseCache(uint64_t maximumSize = 0);
+
+    // Returns the stored response for the resource, and counts the lookup as a hit or a miss.
+    optional<Response> get(const Resource&);
+
+    // Stores a response that the offline database would store. Error responses are ignored,
+    // and Not Modified responses only update the expiration of a stored response.
+    void put(const Resource&, const Response&);
+
+    void setMaximumSize(uint64_t);
+    uint64_t getMaximumSize() const { return maximumSize; }
+    uint64_t getSize() const { return size; }
+
+    uint64_t getHitCount() const { return hitCount; }
+    uint64_t getMissCount() const { return missCount; }
+
+    void clear();
+
+private:
+    // Tiles are identified by their URL template and tile data, everything else by the URL.
+    // Tiles always have a nonzero pixel ratio, so they can't be confused with other resources.
+    using Key = std::tuple<std::string, uint8_t, int32_t, int32_t, int8_t>;
+    static Key makeKey(const Resource&);
+
+    struct Entry {
+        Key key;
+        Response response;
+        uint64_t size;
+    };
+
+    void erase(std::list<Entry>::iterator);
+    void evict();
+
+    // Ordered from the most to the least recently used.
+    std::list<Entry> entries;
+    std::map<Key, std::list<Entry>::iterator> index;
+
+    uint64_t maximumSize;
+    uint64_t size = 0;
+
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+};
+
+} // namespace mbgl
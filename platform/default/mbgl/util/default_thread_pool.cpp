@@ -2,31 +2,60 @@
 #include <mbgl/actor/mailbox.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/thread_local.hpp>
+
+#include <cassert>
+
+namespace {
+
+struct Worker {
+    const mbgl::ThreadPool* pool;
+    std::size_t index;
+};
+
+// Identifies the pool and queue owned by the calling thread, if it is a worker.
+static mbgl::util::ThreadLocal<Worker>& current = *new mbgl::util::ThreadLocal<Worker>;
+
+} // namespace
 
 namespace mbgl {
 
 ThreadPool::ThreadPool(std::size_t count) {
+    assert(count > 0);
+
+    queues.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+
     threads.reserve(count);
     for (std::size_t i = 0; i < count; ++i) {
         threads.emplace_back([this, i]() {
             platform::setCurrentThreadName(std::string{ "Worker " } + util::toString(i + 1));
+            current.set(new Worker { this, i });
 
-            while (true) {
-                std::unique_lock<std::mutex> lock(mutex);
-
-                cv.wait(lock, [this] {
-                    return !queue.empty() || terminate;
-                });
+            std::weak_ptr<Mailbox> mailbox;
 
-                if (terminate) {
-                    return;
+            while (!terminate) {
+                if (take(i, mailbox)) {
+                    const std::size_t previous = pending--;
+                    assert(previous > 0);
+                    (void)previous;
+                    Mailbox::maybeReceive(std::move(mailbox));
+                    mailbox.reset();
+                    continue;
                 }
 
-                auto mailbox = queue.front();
-                queue.pop();
-                lock.unlock();
+                std::unique_lock<std::mutex> lock(mutex);
 
-                Mailbox::maybeReceive(mailbox);
+                // `sleeping` must be incremented before `pending` is checked, and
+                // `schedule()` increments `pending` before checking `sleeping`, so
+                // at least one side is guaranteed to see the other.
+                sleeping++;
+                cv.wait(lock, [this] {
+                    return pending > 0 || terminate;
+                });
+                sleeping--;
             }
         });
     }
@@ -46,12 +75,69 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    auto locked = mailbox.lock();
+    if (!locked) {
+        return;
+    }
+
+    const auto lane = std::size_t(locked->getPriority());
+    locked.reset();
+
+    // Keep mailboxes rescheduled by a worker on that worker, so that an actor
+    // receiving a burst of messages stays hot in one thread's cache.
+    Worker* worker = current.get();
+    const bool local = worker && worker->pool == this;
+    Queue& queue = *queues[local ? worker->index : next++ % queues.size()];
+
+    // `pending` is incremented before the mailbox is queued, so that a worker
+    // taking it right away can't decrement `pending` below zero.
+    pending++;
+
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(mailbox);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.mailboxes[lane].push_back(std::move(mailbox));
+    }
+
+    if (sleeping > 0) {
+        // Acquiring the mutex ensures that a worker that is about to go to sleep
+        // is already waiting on `cv` by the time we notify it.
+        { std::lock_guard<std::mutex> lock(mutex); }
+        cv.notify_one();
+    }
+}
+
+bool ThreadPool::take(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    // Prefer stealing higher priority work from other workers over running
+    // lower priority work of our own.
+    for (std::size_t lane = 0; lane < priorities; ++lane) {
+        {
+            Queue& queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            // Our own most recently scheduled mailbox is the likeliest to still be in cache.
+            auto& mailboxes = queue.mailboxes[lane];
+            if (!mailboxes.empty()) {
+                mailbox = std::move(mailboxes.back());
+                mailboxes.pop_back();
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < queues.size(); ++i) {
+            Queue& victim = *queues[(index + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            // Steal the oldest mailbox, which its owner would run last.
+            auto& mailboxes = victim.mailboxes[lane];
+            if (!mailboxes.empty()) {
+                mailbox = std::move(mailboxes.front());
+                mailboxes.pop_front();
+                return true;
+            }
+        }
     }
 
-    cv.notify_one();
+    return false;
 }
 
 } // namespace mbgl
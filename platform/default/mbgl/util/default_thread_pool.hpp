@@ -2,13 +2,32 @@
 
 #include <mbgl/actor/scheduler.hpp>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+/*
+    A work-stealing `Scheduler`. Every worker thread owns a queue of mailboxes.
+    Mailboxes scheduled from a worker thread (e.g. a mailbox rescheduling itself
+    after `receive()`) go to that worker's own deque; mailboxes scheduled from
+    any other thread are distributed round-robin. A worker runs its own most
+    recently scheduled mailbox first; once it runs out of work, it steals the
+    oldest mailboxes from the other workers' queues before going to sleep.
+
+    Each queue has its own lock, so scheduling and dequeueing from different
+    workers never contend with each other. The shared mutex is only taken to
+    put idle workers to sleep and to wake them up again.
+
+    Every worker has one deque per `Scheduler::Priority`. Workers drain (and
+    steal from) higher priority deques first, so that e.g. the tiles in the
+    center of the viewport are laid out before tiles that are no longer needed.
+*/
 class ThreadPool : public Scheduler {
 public:
     ThreadPool(std::size_t count);
@@ -17,11 +36,27 @@ public:
     void schedule(std::weak_ptr<Mailbox>) override;
 
 private:
+    static constexpr std::size_t priorities = std::size_t(Priority::Low) + 1;
+
+    struct Queue {
+        std::mutex mutex;
+        std::array<std::deque<std::weak_ptr<Mailbox>>, priorities> mailboxes;
+    };
+
+    // Takes the next mailbox from the worker's own queue, or steals one from
+    // another worker's queue.
+    bool take(std::size_t index, std::weak_ptr<Mailbox>&);
+
+    std::vector<std::unique_ptr<Queue>> queues;
     std::vector<std::thread> threads;
-    std::queue<std::weak_ptr<Mailbox>> queue;
+
+    std::atomic<std::size_t> next { 0 };
+
+    std::atomic<std::size_t> pending { 0 };
+    std::atomic<std::size_t> sleeping { 0 };
     std::mutex mutex;
     std::condition_variable cv;
-    bool terminate { false };
+    std::atomic<bool> terminate { false };
 };
 
 } // namespace mbgl
@@ -17,9 +17,11 @@
 
 #include <algorithm>
 #include <cassert>
-#include <list>
+#include <map>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -82,16 +84,17 @@ public:
 
     void remove(OnlineFileRequest* request) {
         allRequests.erase(request);
+        completingRequests.erase(request);
         if (activeRequests.erase(request)) {
-            activatePendingRequest();
+            unsubscribe(request);
         } else {
             auto it = pendingRequestsMap.find(request);
             if (it != pendingRequestsMap.end()) {
-                pendingRequestsList.erase(it->second);
+                pendingRequestsQueue.erase(it->second);
                 pendingRequestsMap.erase(it);
             }
         }
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     void activateOrQueueRequest(OnlineFileRequest* request) {
@@ -99,7 +102,10 @@ public:
         assert(activeRequests.find(request) == activeRequests.end());
         assert(!request->request);
 
-        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests()) {
+        // A request for a resource that is already being transferred joins the transfer, which
+        // doesn't take up another connection.
+        if (sharedRequests.size() >= HTTPFileSource::maximumConcurrentRequests() &&
+            sharedRequests.find(sharedRequestKey(request->resource)) == sharedRequests.end()) {
             queueRequest(request);
         } else {
             activateRequest(request);
@@ -107,34 +113,51 @@ public:
     }
 
     void queueRequest(OnlineFileRequest* request) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), request);
-        pendingRequestsMap.emplace(request, std::move(it));
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        auto it = pendingRequestsQueue.emplace(pendingRequestKey(request->resource, pendingRequestsCount++), request).first;
+        pendingRequestsMap.emplace(request, it);
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
+    }
+
+    void setPriority(OnlineFileRequest* request, uint32_t priority) {
+        request->resource.priority = priority;
+
+        // Move a pending request to its new place in the queue, behind the requests that were
+        // queued earlier with the same priority.
+        auto it = pendingRequestsMap.find(request);
+        if (it != pendingRequestsMap.end()) {
+            const uint64_t sequence = std::get<3>(it->second->first);
+            pendingRequestsQueue.erase(it->second);
+            it->second = pendingRequestsQueue.emplace(pendingRequestKey(request->resource, sequence), request).first;
+        }
     }
 
     void activateRequest(OnlineFileRequest* request) {
         activeRequests.insert(request);
-        request->request = httpFileSource.request(request->resource, [=] (Response response) {
-            activeRequests.erase(request);
-            activatePendingRequest();
-            request->request.reset();
-            request->completed(response);
-        });
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
-    }
 
-    void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
-            return;
+        const SharedRequestKey key = sharedRequestKey(request->resource);
+        auto it = sharedRequests.find(key);
+        if (it == sharedRequests.end()) {
+            it = sharedRequests.emplace(key, SharedRequest()).first;
+            it->second.request = httpFileSource.request(request->resource, [this, key] (Response response) {
+                sharedRequestCompleted(key, response);
+            });
         }
+        it->second.subscribers.push_back(request);
+
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
+    }
 
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+    void activatePendingRequests() {
+        while (!pendingRequestsQueue.empty() &&
+               sharedRequests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+            OnlineFileRequest* request = pendingRequestsQueue.begin()->second;
+            pendingRequestsQueue.erase(pendingRequestsQueue.begin());
 
-        pendingRequestsMap.erase(request);
+            pendingRequestsMap.erase(request);
 
-        activateRequest(request);
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+            activateRequest(request);
+        }
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     bool isPending(OnlineFileRequest* request) {
@@ -150,6 +173,81 @@ public:
     }
 
 private:
+    // Pending requests are served by kind first, so that styles, sources, sprites and glyphs
+    // don't wait behind tiles, then required before optional requests, then by priority, and
+    // finally in the order they were queued.
+    using PendingRequestKey = std::tuple<uint8_t, bool, uint32_t, uint64_t>;
+
+    static PendingRequestKey pendingRequestKey(const Resource& resource, uint64_t sequence) {
+        return PendingRequestKey { kindRank(resource.kind), resource.necessity == Resource::Optional, resource.priority, sequence };
+    }
+
+    static uint8_t kindRank(Resource::Kind kind) {
+        switch (kind) {
+        case Resource::Kind::Style:
+            return 0;
+        case Resource::Kind::Source:
+            return 1;
+        case Resource::Kind::SpriteJSON:
+        case Resource::Kind::SpriteImage:
+        case Resource::Kind::Glyphs:
+            return 2;
+        case Resource::Kind::Tile:
+        case Resource::Kind::Unknown:
+            return 3;
+        }
+        return 3;
+    }
+
+    // Requests share a transfer when they would send the same HTTP request.
+    using SharedRequestKey = std::tuple<Resource::Kind, std::string, optional<std::string>, optional<Timestamp>>;
+
+    static SharedRequestKey sharedRequestKey(const Resource& resource) {
+        return SharedRequestKey { resource.kind, resource.url, resource.priorEtag, resource.priorModified };
+    }
+
+    struct SharedRequest {
+        std::unique_ptr<AsyncRequest> request;
+        std::vector<OnlineFileRequest*> subscribers;
+    };
+
+    // Cancels the transfer of an active request that is going away if no other request needs it.
+    void unsubscribe(OnlineFileRequest* request) {
+        auto it = sharedRequests.find(sharedRequestKey(request->resource));
+        assert(it != sharedRequests.end());
+
+        auto& subscribers = it->second.subscribers;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), request), subscribers.end());
+
+        if (subscribers.empty()) {
+            sharedRequests.erase(it);
+            activatePendingRequests();
+        }
+    }
+
+    void sharedRequestCompleted(SharedRequestKey key, Response response) {
+        auto it = sharedRequests.find(key);
+        assert(it != sharedRequests.end());
+
+        const std::vector<OnlineFileRequest*> subscribers = std::move(it->second.subscribers);
+        sharedRequests.erase(it);
+
+        for (auto request : subscribers) {
+            activeRequests.erase(request);
+            completingRequests.insert(request);
+        }
+
+        activatePendingRequests();
+
+        // Completing a request may delete it or any of the others, which takes them out of
+        // `completingRequests`.
+        for (auto request : subscribers) {
+            if (completingRequests.erase(request)) {
+                request->completed(response);
+            }
+        }
+    }
+
     void networkIsReachableAgain() {
         for (auto& request : allRequests) {
             request->networkIsReachableAgain();
@@ -162,17 +260,24 @@ private:
      * The lifetime of a request is:
      *
      * 1. Waiting for timeout (revalidation or retry)
-     * 2. Pending (waiting for room in the active set)
+     * 2. Pending (waiting for room in the active set, in order of priority)
      * 3. Active (open network connection)
      * 4. Back to #1
      *
      * Requests in any state are in `allRequests`. Requests in the pending state are in
-     * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     * `pendingRequestsQueue`, and `pendingRequestsMap` finds their place in it. Requests in
+     * the active state are in `activeRequests`, and subscribed to one of the `sharedRequests`,
+     * each of which is an open network connection.
      */
     std::unordered_set<OnlineFileRequest*> allRequests;
-    std::list<OnlineFileRequest*> pendingRequestsList;
-    std::unordered_map<OnlineFileRequest*, std::list<OnlineFileRequest*>::iterator> pendingRequestsMap;
+    std::map<PendingRequestKey, OnlineFileRequest*> pendingRequestsQueue;
+    std::unordered_map<OnlineFileRequest*, std::map<PendingRequestKey, OnlineFileRequest*>::iterator> pendingRequestsMap;
+    uint64_t pendingRequestsCount = 0;
     std::unordered_set<OnlineFileRequest*> activeRequests;
+    std::map<SharedRequestKey, SharedRequest> sharedRequests;
+
+    // Requests whose transfer completed, and which haven't been handed the response yet.
+    std::unordered_set<OnlineFileRequest*> completingRequests;
 
     HTTPFileSource httpFileSource;
     util::AsyncTask reachability { std::bind(&Impl::networkIsReachableAgain, this) };
@@ -216,6 +321,12 @@ std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource
     return std::make_unique<OnlineFileRequest>(std::move(res), std::move(callback), *impl);
 }
 
+void OnlineFileSource::setPriority(AsyncRequest& req, uint32_t priority) {
+    if (auto request = dynamic_cast<OnlineFileRequest*>(&req)) {
+        impl->setPriority(request, priority);
+    }
+}
+
 void OnlineFileSource::setResourceTransform(ResourceTransform&& transform) {
     impl->setResourceTransform(std::move(transform));
 }
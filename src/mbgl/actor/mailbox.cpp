@@ -52,6 +52,14 @@ void Mailbox::receive() {
     }
 }
 
+void Mailbox::setPriority(Scheduler::Priority priority_) {
+    priority = priority_;
+}
+
+Scheduler::Priority Mailbox::getPriority() const {
+    return priority;
+}
+
 void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox) {
     if (auto locked = mailbox.lock()) {
         locked->receive();
@@ -1,12 +1,14 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
+
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <queue>
 
 namespace mbgl {
 
-class Scheduler;
 class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
@@ -18,10 +20,15 @@ public:
     void close();
     void receive();
 
+    // Takes effect the next time this mailbox is scheduled.
+    void setPriority(Scheduler::Priority);
+    Scheduler::Priority getPriority() const;
+
     static void maybeReceive(std::weak_ptr<Mailbox>);
 
 private:
     Scheduler& scheduler;
+    std::atomic<Scheduler::Priority> priority { Scheduler::Priority::Normal };
 
     std::mutex closingMutex;
     bool closing { false };
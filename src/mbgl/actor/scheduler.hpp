@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace mbgl {
@@ -19,7 +20,9 @@ class Mailbox;
         concurrency within a mailbox
 
       Subject to these constraints, processing can happen on whatever thread in the
-      pool is available.
+      pool is available. Each thread has its own queue of mailboxes, and idle threads
+      steal work from busy ones. Mailboxes with a higher `Priority` are processed
+      before mailboxes with a lower one.
 
     * `RunLoop` is a `Scheduler` that is typically used to create a mailbox and
       `ActorRef` for an object that lives on the main thread and is not itself wrapped
@@ -31,6 +34,15 @@ class Mailbox;
 
 class Scheduler {
 public:
+    // The relative urgency of a mailbox, see `Mailbox::setPriority`. Schedulers that
+    // don't support priorities are free to ignore it. Priorities never change the
+    // order in which messages within a single mailbox are processed.
+    enum class Priority : uint8_t {
+        High,
+        Normal,
+        Low,
+    };
+
     virtual ~Scheduler() = default;
     virtual void schedule(std::weak_ptr<Mailbox>) = 0;
 };
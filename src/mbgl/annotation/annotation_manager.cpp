@@ -9,15 +9,20 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/string.hpp>
 
 #include <boost/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace mbgl {
 
 using namespace style;
 
 const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
+const std::string AnnotationManager::ShapeLayerID = "com.mapbox.annotations.shape.";
 
 AnnotationManager::AnnotationManager(float pixelRatio)
     : spriteAtlas({ 1024, 1024 }, pixelRatio) {
@@ -57,7 +62,14 @@ void AnnotationManager::removeAnnotation(const AnnotationID& id) {
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
-        obsoleteShapeAnnotationLayers.insert(shapeAnnotations.at(id)->layerID);
+        ShapeAnnotationBatch* batch = shapeAnnotationBatchIndex.at(id);
+        batch->remove(id);
+        if (batch->empty()) {
+            obsoleteShapeAnnotationLayers.insert(batch->layerID);
+            shapeAnnotationBatches.erase(std::find_if(shapeAnnotationBatches.begin(), shapeAnnotationBatches.end(),
+                [&] (const auto& batch_) { return batch_.get() == batch; }));
+        }
+        shapeAnnotationBatchIndex.erase(id);
         shapeAnnotations.erase(id);
     } else {
         assert(false); // Should never happen
@@ -71,21 +83,33 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
-    obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    add(std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
-    obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    add(std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const StyleSourcedAnnotation& annotation, const uint8_t maxZoom) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom)).first->second;
-    obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    add(std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom));
+}
+
+void AnnotationManager::add(std::unique_ptr<ShapeAnnotationImpl> impl) {
+    // Draw the annotation with the topmost layer if the paint properties allow for it. Adding
+    // it to a layer below would draw it below annotations that were added after it.
+    ShapeAnnotationBatch* batch;
+    if (!shapeAnnotationBatches.empty() && shapeAnnotationBatches.back()->canAdd(*impl)) {
+        batch = shapeAnnotationBatches.back().get();
+        batch->add(*impl);
+    } else {
+        shapeAnnotationBatches.push_back(std::make_unique<ShapeAnnotationBatch>(
+            ShapeLayerID + util::toString(nextShapeAnnotationBatchID++), *impl));
+        batch = shapeAnnotationBatches.back().get();
+    }
+
+    const AnnotationID id = impl->id;
+    shapeAnnotationBatchIndex.emplace(id, batch);
+    shapeAnnotations.emplace(id, std::move(impl));
 }
 
 Update AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t maxZoom) {
@@ -120,7 +144,7 @@ Update AnnotationManager::update(const AnnotationID& id, const LineAnnotation& a
         assert(false); // Attempt to update a non-existent shape annotation
         return Update::Nothing;
     }
-    removeAndAdd(id, annotation, maxZoom);
+    replace(std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom));
     return Update::AnnotationData | Update::AnnotationStyle;
 }
 
@@ -130,7 +154,7 @@ Update AnnotationManager::update(const AnnotationID& id, const FillAnnotation& a
         assert(false); // Attempt to update a non-existent shape annotation
         return Update::Nothing;
     }
-    removeAndAdd(id, annotation, maxZoom);
+    replace(std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom));
     return Update::AnnotationData | Update::AnnotationStyle;
 }
 
@@ -140,10 +164,29 @@ Update AnnotationManager::update(const AnnotationID& id, const StyleSourcedAnnot
         assert(false); // Attempt to update a non-existent shape annotation
         return Update::Nothing;
     }
-    removeAndAdd(id, annotation, maxZoom);
+    replace(std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom));
     return Update::AnnotationData | Update::AnnotationStyle;
 }
 
+void AnnotationManager::replace(std::unique_ptr<ShapeAnnotationImpl> impl) {
+    // Keep the annotation in its layer if the batch can draw it, so that an update doesn't move
+    // it above annotations that were added after it. A batch that holds nothing else can take
+    // any annotation that is drawn with the same type of layer.
+    const AnnotationID id = impl->id;
+    ShapeAnnotationBatch* batch = shapeAnnotationBatchIndex.at(id);
+    const ShapeAnnotationImpl& existing = *shapeAnnotations.at(id);
+    const bool alone = batch->getShapes().size() == 1 && typeid(existing) == typeid(*impl);
+
+    if (!alone && !batch->canAdd(*impl)) {
+        removeAnnotation(id);
+        add(std::move(impl));
+        return;
+    }
+
+    batch->add(*impl);
+    shapeAnnotations[id] = std::move(impl);
+}
+
 void AnnotationManager::removeAndAdd(const AnnotationID& id, const Annotation& annotation, const uint8_t maxZoom) {
     removeAnnotation(id);
     Annotation::visit(annotation, [&] (const auto& annotation_) {
@@ -166,8 +209,8 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
             val->updateLayer(tileID, pointLayer);
         }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    for (const auto& batch : shapeAnnotationBatches) {
+        batch->updateTileData(tileID, *tileData);
     }
 
     return tileData;
@@ -192,8 +235,8 @@ void AnnotationManager::updateStyle(Style& style) {
         style.addLayer(std::move(layer));
     }
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateStyle(style);
+    for (const auto& batch : shapeAnnotationBatches) {
+        batch->updateStyle(style);
     }
 
     for (const auto& layer : obsoleteShapeAnnotationLayers) {
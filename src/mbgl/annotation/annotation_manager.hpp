@@ -18,6 +18,7 @@ class AnnotationTile;
 class AnnotationTileData;
 class SymbolAnnotationImpl;
 class ShapeAnnotationImpl;
+class ShapeAnnotationBatch;
 
 namespace style {
 class Style;
@@ -45,6 +46,7 @@ public:
 
     static const std::string SourceID;
     static const std::string PointLayerID;
+    static const std::string ShapeLayerID;
 
 private:
     void add(const AnnotationID&, const SymbolAnnotation&, const uint8_t);
@@ -57,21 +59,28 @@ private:
     Update update(const AnnotationID&, const FillAnnotation&, const uint8_t);
     Update update(const AnnotationID&, const StyleSourcedAnnotation&, const uint8_t);
 
+    void add(std::unique_ptr<ShapeAnnotationImpl>);
+    void replace(std::unique_ptr<ShapeAnnotationImpl>);
     void removeAndAdd(const AnnotationID&, const Annotation&, const uint8_t);
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
 
     AnnotationID nextID = 0;
+    uint32_t nextShapeAnnotationBatchID = 0;
 
     using SymbolAnnotationTree = boost::geometry::index::rtree<std::shared_ptr<const SymbolAnnotationImpl>, boost::geometry::index::rstar<16, 4>>;
     // Unlike std::unordered_map, std::map is guaranteed to sort by AnnotationID, ensuring that older annotations are below newer annotations.
     // <https://github.com/mapbox/mapbox-gl-native/issues/5691>
     using SymbolAnnotationMap = std::map<AnnotationID, std::shared_ptr<SymbolAnnotationImpl>>;
     using ShapeAnnotationMap = std::map<AnnotationID, std::unique_ptr<ShapeAnnotationImpl>>;
+    // Batches are kept in the order they were created in, which is the order of their layers.
+    using ShapeAnnotationBatches = std::vector<std::unique_ptr<ShapeAnnotationBatch>>;
 
     SymbolAnnotationTree symbolTree;
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
+    ShapeAnnotationBatches shapeAnnotationBatches;
+    std::unordered_map<AnnotationID, ShapeAnnotationBatch*> shapeAnnotationBatchIndex;
     std::unordered_set<std::string> obsoleteShapeAnnotationLayers;
     std::unordered_set<AnnotationTile*> tiles;
     SpriteAtlas spriteAtlas;
@@ -23,7 +23,7 @@ void AnnotationTile::setNecessity(Necessity) {}
 
 AnnotationTileFeature::AnnotationTileFeature(const AnnotationID id_,
                                              FeatureType type_, GeometryCollection geometries_,
-                                             std::unordered_map<std::string, std::string> properties_)
+                                             PropertyMap properties_)
     : id(id_),
       type(type_),
       properties(std::move(properties_)),
@@ -32,18 +32,22 @@ AnnotationTileFeature::AnnotationTileFeature(const AnnotationID id_,
 optional<Value> AnnotationTileFeature::getValue(const std::string& key) const {
     auto it = properties.find(key);
     if (it != properties.end()) {
-        return optional<Value>(it->second);
+        return it->second;
     }
     return optional<Value>();
 }
 
+FeatureValue AnnotationTileFeature::lookupValue(const std::string& key) const {
+    auto it = properties.find(key);
+    if (it != properties.end()) {
+        return &it->second;
+    }
+    return FeatureValue();
+}
+
 AnnotationTileLayer::AnnotationTileLayer(std::string name_)
     : name(std::move(name_)) {}
 
-std::unique_ptr<GeometryTileData> AnnotationTileData::clone() const {
-    return std::make_unique<AnnotationTileData>(*this);
-}
-
 const GeometryTileLayer* AnnotationTileData::getLayer(const std::string& name) const {
     auto it = layers.find(name);
     if (it != layers.end()) {
@@ -27,16 +27,17 @@ private:
 class AnnotationTileFeature : public GeometryTileFeature {
 public:
     AnnotationTileFeature(AnnotationID, FeatureType, GeometryCollection,
-                          std::unordered_map<std::string, std::string> properties = {{}});
+                          PropertyMap properties = {});
 
     FeatureType getType() const override { return type; }
     optional<Value> getValue(const std::string&) const override;
+    FeatureValue lookupValue(const std::string&) const override;
     optional<FeatureIdentifier> getID() const override { return { static_cast<uint64_t>(id) }; }
     GeometryCollection getGeometries() const override { return geometries; }
 
     const AnnotationID id;
     const FeatureType type;
-    const std::unordered_map<std::string, std::string> properties;
+    const PropertyMap properties;
     const GeometryCollection geometries;
 };
 
@@ -60,7 +61,6 @@ private:
 
 class AnnotationTileData : public GeometryTileData {
 public:
-    std::unique_ptr<GeometryTileData> clone() const override;
     const GeometryTileLayer* getLayer(const std::string&) const override;
 
     std::unordered_map<std::string, AnnotationTileLayer> layers;
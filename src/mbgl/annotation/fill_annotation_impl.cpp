@@ -12,7 +12,15 @@ FillAnnotationImpl::FillAnnotationImpl(AnnotationID id_, FillAnnotation annotati
       annotation({ ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}), annotation_.opacity, annotation_.color, annotation_.outlineColor }) {
 }
 
-void FillAnnotationImpl::updateStyle(Style& style) const {
+bool FillAnnotationImpl::canBatchWith(const ShapeAnnotationImpl& shape) const {
+    auto fill = dynamic_cast<const FillAnnotationImpl*>(&shape);
+    return fill
+        && canBatch(fill->annotation.opacity, annotation.opacity)
+        && canBatch(fill->annotation.color, annotation.color)
+        && canBatch(fill->annotation.outlineColor, annotation.outlineColor);
+}
+
+void FillAnnotationImpl::updateStyle(Style& style, const std::string& layerID, const ShapeAnnotationBatch& batch) const {
     Layer* layer = style.getLayer(layerID);
 
     if (!layer) {
@@ -22,9 +30,24 @@ void FillAnnotationImpl::updateStyle(Style& style) const {
     }
 
     FillLayer* fillLayer = layer->as<FillLayer>();
-    fillLayer->setFillOpacity(annotation.opacity);
-    fillLayer->setFillColor(annotation.color);
-    fillLayer->setFillOutlineColor(annotation.outlineColor);
+    fillLayer->setFillOpacity(batchedValue(annotation.opacity, "opacity"));
+    fillLayer->setFillColor(batchedColor(annotation.color, batch, [] (const ShapeAnnotationImpl& shape) {
+        return static_cast<const FillAnnotationImpl&>(shape).annotation.color;
+    }));
+    fillLayer->setFillOutlineColor(batchedColor(annotation.outlineColor, batch, [] (const ShapeAnnotationImpl& shape) {
+        return static_cast<const FillAnnotationImpl&>(shape).annotation.outlineColor;
+    }));
+}
+
+PropertyMap FillAnnotationImpl::properties() const {
+    PropertyMap result;
+    if (auto opacity = constantValue(annotation.opacity)) {
+        result.emplace("opacity", double(*opacity));
+    }
+    if (constantValue(annotation.color) || constantValue(annotation.outlineColor)) {
+        result.emplace(ShapeAnnotationIDProperty, uint64_t(id));
+    }
+    return result;
 }
 
 const ShapeAnnotationGeometry& FillAnnotationImpl::geometry() const {
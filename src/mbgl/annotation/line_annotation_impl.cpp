@@ -12,7 +12,15 @@ LineAnnotationImpl::LineAnnotationImpl(AnnotationID id_, LineAnnotation annotati
       annotation({ ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}), annotation_.opacity, annotation_.width, annotation_.color }) {
 }
 
-void LineAnnotationImpl::updateStyle(Style& style) const {
+bool LineAnnotationImpl::canBatchWith(const ShapeAnnotationImpl& shape) const {
+    auto line = dynamic_cast<const LineAnnotationImpl*>(&shape);
+    return line
+        && line->annotation.width == annotation.width
+        && canBatch(line->annotation.opacity, annotation.opacity)
+        && canBatch(line->annotation.color, annotation.color);
+}
+
+void LineAnnotationImpl::updateStyle(Style& style, const std::string& layerID, const ShapeAnnotationBatch& batch) const {
     Layer* layer = style.getLayer(layerID);
 
     if (!layer) {
@@ -23,9 +31,22 @@ void LineAnnotationImpl::updateStyle(Style& style) const {
     }
 
     LineLayer* lineLayer = layer->as<LineLayer>();
-    lineLayer->setLineOpacity(annotation.opacity);
+    lineLayer->setLineOpacity(batchedValue(annotation.opacity, "opacity"));
     lineLayer->setLineWidth(annotation.width);
-    lineLayer->setLineColor(annotation.color);
+    lineLayer->setLineColor(batchedColor(annotation.color, batch, [] (const ShapeAnnotationImpl& shape) {
+        return static_cast<const LineAnnotationImpl&>(shape).annotation.color;
+    }));
+}
+
+PropertyMap LineAnnotationImpl::properties() const {
+    PropertyMap result;
+    if (auto opacity = constantValue(annotation.opacity)) {
+        result.emplace("opacity", double(*opacity));
+    }
+    if (constantValue(annotation.color)) {
+        result.emplace(ShapeAnnotationIDProperty, uint64_t(id));
+    }
+    return result;
 }
 
 const ShapeAnnotationGeometry& LineAnnotationImpl::geometry() const {
@@ -9,8 +9,10 @@ class LineAnnotationImpl : public ShapeAnnotationImpl {
 public:
     LineAnnotationImpl(AnnotationID, LineAnnotation, uint8_t maxZoom);
 
-    void updateStyle(style::Style&) const final;
+    bool canBatchWith(const ShapeAnnotationImpl&) const final;
+    void updateStyle(style::Style&, const std::string& layerID, const ShapeAnnotationBatch&) const final;
     const ShapeAnnotationGeometry& geometry() const final;
+    PropertyMap properties() const final;
 
 private:
     const LineAnnotation annotation;
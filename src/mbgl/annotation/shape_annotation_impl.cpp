@@ -2,8 +2,6 @@
 #include <mbgl/annotation/annotation_tile.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/math/wrap.hpp>
-#include <mbgl/math/clamp.hpp>
-#include <mbgl/util/string.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
 
@@ -14,20 +12,57 @@ namespace geojsonvt = mapbox::geojsonvt;
 
 ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t maxZoom_)
     : id(id_),
-      maxZoom(maxZoom_),
-      layerID("com.mapbox.annotations.shape." + util::toString(id)) {
+      maxZoom(maxZoom_) {
 }
 
-void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
+ShapeAnnotationBatch::ShapeAnnotationBatch(std::string layerID_, const ShapeAnnotationImpl& shape)
+    : layerID(std::move(layerID_)) {
+    add(shape);
+}
+
+bool ShapeAnnotationBatch::canAdd(const ShapeAnnotationImpl& shape) const {
+    if (shapes.empty()) {
+        return false;
+    }
+    const ShapeAnnotationImpl& batched = *shapes.begin()->second;
+    return batched.maxZoom == shape.maxZoom && batched.canBatchWith(shape);
+}
+
+void ShapeAnnotationBatch::add(const ShapeAnnotationImpl& shape) {
+    shapes[shape.id] = &shape;
+    shapeTiler.reset();
+}
+
+void ShapeAnnotationBatch::remove(const AnnotationID id) {
+    shapes.erase(id);
+    shapeTiler.reset();
+}
+
+void ShapeAnnotationBatch::updateStyle(Style& style) const {
+    if (!shapes.empty()) {
+        shapes.begin()->second->updateStyle(style, layerID, *this);
+    }
+}
+
+void ShapeAnnotationBatch::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
     static const double baseTolerance = 4;
 
+    if (shapes.empty()) {
+        return;
+    }
+
     if (!shapeTiler) {
         mapbox::geometry::feature_collection<double> features;
-        features.emplace_back(ShapeAnnotationGeometry::visit(geometry(), [] (auto&& geom) {
-            return Feature { std::move(geom) };
-        }));
+        features.reserve(shapes.size());
+        for (const auto& shape : shapes) {
+            features.emplace_back(ShapeAnnotationGeometry::visit(shape.second->geometry(), [] (auto&& geom) {
+                return Feature { std::move(geom) };
+            }));
+            features.back().properties = shape.second->properties();
+            features.back().id = FeatureIdentifier(uint64_t(shape.first));
+        }
         mapbox::geojsonvt::Options options;
-        options.maxZoom = maxZoom;
+        options.maxZoom = shapes.begin()->second->maxZoom;
         options.buffer = 255u;
         options.extent = util::EXTENT;
         options.tolerance = baseTolerance;
@@ -39,6 +74,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         return;
 
     AnnotationTileLayer& layer = data.layers.emplace(layerID, layerID).first->second;
+    layer.features.reserve(shapeTile.features.size());
 
     ToGeometryCollection toGeometryCollection;
     ToFeatureType toFeatureType;
@@ -47,13 +83,15 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         GeometryCollection renderGeometry = apply_visitor(toGeometryCollection, shapeFeature.geometry);
 
         assert(featureType != FeatureType::Unknown);
+        assert(shapeFeature.id && shapeFeature.id->is<uint64_t>());
 
         // https://github.com/mapbox/geojson-vt-cpp/issues/44
         if (featureType == FeatureType::Polygon) {
             renderGeometry = fixupPolygons(renderGeometry);
         }
 
-        layer.features.emplace_back(id, featureType, renderGeometry);
+        layer.features.emplace_back(AnnotationID(shapeFeature.id->get<uint64_t>()), featureType,
+                                    renderGeometry, shapeFeature.properties);
     }
 }
 
@@ -3,8 +3,11 @@
 #include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/util/optional.hpp>
 
+#include <map>
 #include <string>
 #include <memory>
 
@@ -12,6 +15,7 @@ namespace mbgl {
 
 class AnnotationTileData;
 class CanonicalTileID;
+class ShapeAnnotationBatch;
 
 namespace style {
 class Style;
@@ -22,17 +26,100 @@ public:
     ShapeAnnotationImpl(const AnnotationID, const uint8_t maxZoom);
     virtual ~ShapeAnnotationImpl() = default;
 
-    virtual void updateStyle(style::Style&) const = 0;
+    // Whether this annotation can be drawn by the same style layer as the given one.
+    virtual bool canBatchWith(const ShapeAnnotationImpl&) const = 0;
+
+    // Adds or updates the style layer with the given ID, drawing a batch of annotations
+    // that this annotation can be batched with.
+    virtual void updateStyle(style::Style&, const std::string& layerID, const ShapeAnnotationBatch&) const = 0;
+
     virtual const ShapeAnnotationGeometry& geometry() const = 0;
 
-    void updateTileData(const CanonicalTileID&, AnnotationTileData&);
+    // Feature properties read by the data-driven paint properties of the batch layer.
+    virtual PropertyMap properties() const { return {}; }
 
     const AnnotationID id;
     const uint8_t maxZoom;
+};
+
+// Shape annotations sharing one style layer and one tiler. Paint property values that differ
+// between the annotations are passed on as feature properties.
+class ShapeAnnotationBatch {
+public:
+    // Sorted by AnnotationID, so that newer annotations are drawn above older ones.
+    using Shapes = std::map<AnnotationID, const ShapeAnnotationImpl*>;
+
+    ShapeAnnotationBatch(std::string layerID, const ShapeAnnotationImpl&);
+
+    bool canAdd(const ShapeAnnotationImpl&) const;
+    void add(const ShapeAnnotationImpl&);
+    void remove(const AnnotationID);
+    bool empty() const { return shapes.empty(); }
+    const Shapes& getShapes() const { return shapes; }
+
+    void updateStyle(style::Style&) const;
+    void updateTileData(const CanonicalTileID&, AnnotationTileData&);
+
     const std::string layerID;
+
+private:
+    Shapes shapes;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
 };
 
+// Helpers for batching paint properties: annotations with a constant value are batched
+// together, and pass the value on as a feature property read by an identity function.
+// Constant colors are looked up by annotation ID instead, as feature properties could only
+// hold them as strings. Other values are only batched with equal values.
+template <class T>
+struct ConstantValue {
+    optional<T> operator()(const T& constant) const {
+        return constant;
+    }
+
+    template <class U>
+    optional<T> operator()(const U&) const {
+        return {};
+    }
+};
+
+template <class T>
+optional<T> constantValue(const style::DataDrivenPropertyValue<T>& value) {
+    return value.evaluate(ConstantValue<T>());
+}
+
+template <class T>
+bool canBatch(const style::DataDrivenPropertyValue<T>& a, const style::DataDrivenPropertyValue<T>& b) {
+    const bool aConstant = bool(constantValue(a));
+    const bool bConstant = bool(constantValue(b));
+    return aConstant == bConstant && (aConstant || a == b);
+}
+
+template <class T>
+style::DataDrivenPropertyValue<T> batchedValue(const style::DataDrivenPropertyValue<T>& value, const std::string& property) {
+    if (constantValue(value)) {
+        return style::SourceFunction<T>(property, style::IdentityStops<T>());
+    }
+    return value;
+}
+
+// The feature property holding the annotation ID, for looking up batched colors.
+constexpr const char* ShapeAnnotationIDProperty = "annotation-id";
+
+template <class GetColor>
+style::DataDrivenPropertyValue<Color> batchedColor(const style::DataDrivenPropertyValue<Color>& value,
+                                                   const ShapeAnnotationBatch& batch,
+                                                   GetColor getColor) {
+    if (!constantValue(value)) {
+        return value;
+    }
+    style::CategoricalStops<Color>::Stops stops;
+    for (const auto& shape : batch.getShapes()) {
+        stops.emplace(int64_t(shape.first), *constantValue(getColor(*shape.second)));
+    }
+    return style::SourceFunction<Color>(ShapeAnnotationIDProperty, style::CategoricalStops<Color>(std::move(stops)));
+}
+
 struct CloseShapeAnnotation {
     ShapeAnnotationGeometry operator()(const mbgl::LineString<double> &geom) const {
         return geom;
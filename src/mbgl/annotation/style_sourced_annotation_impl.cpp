@@ -15,7 +15,12 @@ StyleSourcedAnnotationImpl::StyleSourcedAnnotationImpl(AnnotationID id_, StyleSo
       annotation(std::move(annotation_)) {
 }
 
-void StyleSourcedAnnotationImpl::updateStyle(Style& style) const {
+bool StyleSourcedAnnotationImpl::canBatchWith(const ShapeAnnotationImpl& shape) const {
+    auto styleSourced = dynamic_cast<const StyleSourcedAnnotationImpl*>(&shape);
+    return styleSourced && styleSourced->annotation.layerID == annotation.layerID;
+}
+
+void StyleSourcedAnnotationImpl::updateStyle(Style& style, const std::string& layerID, const ShapeAnnotationBatch&) const {
     if (style.getLayer(layerID))
         return;
 
@@ -9,7 +9,8 @@ class StyleSourcedAnnotationImpl : public ShapeAnnotationImpl {
 public:
     StyleSourcedAnnotationImpl(AnnotationID, StyleSourcedAnnotation, uint8_t maxZoom);
 
-    void updateStyle(style::Style&) const final;
+    bool canBatchWith(const ShapeAnnotationImpl&) const final;
+    void updateStyle(style::Style&, const std::string& layerID, const ShapeAnnotationBatch&) const final;
     const ShapeAnnotationGeometry& geometry() const final;
 
 private:
@@ -14,6 +14,7 @@
 #include <mapbox/geometry/envelope.hpp>
 
 #include <cassert>
+#include <limits>
 #include <string>
 
 namespace mbgl {
@@ -22,16 +23,54 @@ FeatureIndex::FeatureIndex()
     : grid(util::EXTENT, 16, 0) {
 }
 
+uint16_t FeatureIndex::internName(const std::string& name) {
+    auto it = nameIndices.find(name);
+    if (it != nameIndices.end()) {
+        return it->second;
+    }
+
+    assert(names.size() < std::numeric_limits<uint16_t>::max());
+    const auto nameIndex = uint16_t(names.size());
+    names.push_back(name);
+    nameIndices.emplace(name, nameIndex);
+    return nameIndex;
+}
+
+const std::string& FeatureIndex::getName(uint16_t nameIndex) const {
+    return names.at(nameIndex);
+}
+
 void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
-                          const std::string& sourceLayerName,
-                          const std::string& bucketName) {
+                          uint16_t sourceLayerName,
+                          uint16_t bucketName) {
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
-                    mapbox::geometry::envelope(ring));
+        insert(ring, index, sourceLayerName, bucketName);
     }
 }
 
+void FeatureIndex::insert(const GeometryCoordinates& ring,
+                          std::size_t index,
+                          uint16_t sourceLayerName,
+                          uint16_t bucketName) {
+    insert(mapbox::geometry::envelope(ring), index, sourceLayerName, bucketName);
+}
+
+void FeatureIndex::insert(const Envelope& envelope,
+                          std::size_t index,
+                          uint16_t sourceLayerName,
+                          uint16_t bucketName) {
+    grid.insert(IndexedSubfeature { uint32_t(index), sourceLayerName, bucketName, sortIndex++ },
+                envelope);
+}
+
+void FeatureIndex::build() {
+    grid.build();
+
+    // Only needed while inserting.
+    nameIndices = {};
+}
+
 static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
@@ -45,8 +84,8 @@ static bool vectorsIntersect(const std::vector<std::string>& vectorA, const std:
     return false;
 }
 
-static bool topDown(const IndexedSubfeature& a, const IndexedSubfeature& b) {
-    return a.sortIndex > b.sortIndex;
+static bool topDown(const IndexedSubfeature* a, const IndexedSubfeature* b) {
+    return a->sortIndex > b->sortIndex;
 }
 
 static bool topDownSymbols(const IndexedSubfeature& a, const IndexedSubfeature& b) {
@@ -69,17 +108,20 @@ void FeatureIndex::query(
 
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
     const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(style.getQueryRadius() * pixelsToTileUnits));
-    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
+    std::vector<const IndexedSubfeature*> features;
+    grid.query({ box.min - additionalRadius, box.max + additionalRadius }, [&](const IndexedSubfeature& feature) {
+        features.push_back(&feature);
+    });
 
     std::sort(features.begin(), features.end(), topDown);
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    for (const auto indexedFeature : features) {
 
         // If this feature is the same as the previous feature, skip it.
-        if (indexedFeature.sortIndex == previousSortIndex) continue;
-        previousSortIndex = indexedFeature.sortIndex;
+        if (indexedFeature->sortIndex == previousSortIndex) continue;
+        previousSortIndex = indexedFeature->sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, *indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -110,7 +152,7 @@ void FeatureIndex::addFeature(
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    auto sourceLayer = geometryTileData.getLayer(getName(indexedFeature.sourceLayerName));
     assert(sourceLayer);
 
     auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
@@ -159,7 +201,21 @@ optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
 }
 
 void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs) {
-    bucketLayerIDs[bucketName] = layerIDs;
+    bucketLayerIDs[internName(bucketName)] = layerIDs;
+}
+
+std::size_t FeatureIndex::byteSize() const {
+    std::size_t size = grid.byteSize();
+    for (const auto& name : names) {
+        size += sizeof(std::string) + name.capacity();
+    }
+    for (const auto& pair : bucketLayerIDs) {
+        size += sizeof(pair);
+        for (const auto& layerID : pair.second) {
+            size += sizeof(std::string) + layerID.capacity();
+        }
+    }
+    return size;
 }
 
 } // namespace mbgl
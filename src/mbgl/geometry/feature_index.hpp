@@ -23,17 +23,31 @@ class CanonicalTileID;
 class IndexedSubfeature {
 public:
     IndexedSubfeature() = delete;
-    std::size_t index;
-    std::string sourceLayerName;
-    std::string bucketName;
-    size_t sortIndex;
+    uint32_t index;
+    // Indices into the name table of the tile's FeatureIndex, see FeatureIndex::internName.
+    uint16_t sourceLayerName;
+    uint16_t bucketName;
+    uint32_t sortIndex;
 };
 
 class FeatureIndex {
 public:
     FeatureIndex();
 
-    void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
+    // Returns the index of `name` in this tile's table of source layer and bucket names,
+    // adding it if necessary. IndexedSubfeatures refer to names by these indices, so that
+    // every name is stored once per tile rather than once per geometry.
+    uint16_t internName(const std::string& name);
+    const std::string& getName(uint16_t) const;
+
+    using Envelope = GridIndex<IndexedSubfeature>::BBox;
+
+    void insert(const GeometryCollection&, std::size_t index, uint16_t sourceLayerName, uint16_t bucketName);
+    void insert(const GeometryCoordinates&, std::size_t index, uint16_t sourceLayerName, uint16_t bucketName);
+    void insert(const Envelope&, std::size_t index, uint16_t sourceLayerName, uint16_t bucketName);
+
+    // Must be called after the last insert(), before the index is queried.
+    void build();
 
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -56,6 +70,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Approximate heap memory held by the index, in bytes.
+    std::size_t byteSize() const;
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -71,6 +88,9 @@ private:
     GridIndex<IndexedSubfeature> grid;
     unsigned int sortIndex = 0;
 
-    std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint16_t> nameIndices;
+
+    std::unordered_map<uint16_t, std::vector<std::string>> bucketLayerIDs;
 };
 } // namespace mbgl
@@ -10,18 +10,28 @@ namespace mbgl {
 
 class SymbolFeature : public GeometryTileFeature {
 public:
-    SymbolFeature(std::unique_ptr<GeometryTileFeature> feature_) :
-        feature(std::move(feature_)),
-        geometry(feature->getGeometries()) // we need a mutable copy of the geometry for mergeLines()
+    SymbolFeature(std::unique_ptr<GeometryTileFeature> feature_, GeometryTileLayerKeys* keys_ = nullptr) :
+        SymbolFeature(*feature_, keys_) {
+        ownedFeature = std::move(feature_);
+    }
+
+    // Refers to a feature that outlives it, e.g. one made in the layout arena of its tile.
+    SymbolFeature(const GeometryTileFeature& feature_, GeometryTileLayerKeys* keys_ = nullptr) :
+        feature(&feature_),
+        keys(keys_),
+        geometry(feature_.getGeometries()) // we need a mutable copy of the geometry for mergeLines()
     {}
     
     FeatureType getType() const override { return feature->getType(); }
-    optional<Value> getValue(const std::string& key) const override { return feature->getValue(key); };
+    optional<Value> getValue(const std::string& key) const override { return lookupValue(key).toOptional(); };
+    FeatureValue lookupValue(const std::string& key) const override { return keys ? keys->getValue(*feature, key) : feature->lookupValue(key); };
     std::unordered_map<std::string,Value> getProperties() const override { return feature->getProperties(); };
     optional<FeatureIdentifier> getID() const override { return feature->getID(); };
     GeometryCollection getGeometries() const override { return geometry; };
 
-    std::unique_ptr<GeometryTileFeature> feature;
+    const GeometryTileFeature* feature;
+    std::unique_ptr<GeometryTileFeature> ownedFeature;
+    GeometryTileLayerKeys* keys;
     GeometryCollection geometry;
     optional<std::u16string> text;
     optional<std::string> icon;
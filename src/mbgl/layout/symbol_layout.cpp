@@ -11,6 +11,7 @@
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/collision_tile.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/token.hpp>
@@ -23,6 +24,7 @@
 #include <mbgl/math/log2.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
 
 #include <mapbox/polylabel.hpp>
 
@@ -33,9 +35,11 @@ using namespace style;
 SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            const std::vector<const Layer*>& layers,
                            const GeometryTileLayer& sourceLayer,
+                           FeatureIndex& featureIndex,
+                           util::MonotonicArena& arena,
                            SpriteAtlas& spriteAtlas_)
-    : sourceLayerName(sourceLayer.getName()),
-      bucketName(layers.at(0)->getID()),
+    : sourceLayerName(featureIndex.internName(sourceLayer.getName())),
+      bucketName(featureIndex.internName(layers.at(0)->getID())),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
       mode(parameters.mode),
@@ -93,19 +97,21 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         ));
     }
 
-    // Determine and load glyph ranges
+    // Determine and load glyph ranges. The features stay in the arena until the worker lays out
+    // the tile again, which is after this layout is gone.
     const size_t featureCount = sourceLayer.featureCount();
     for (size_t i = 0; i < featureCount; ++i) {
-        auto feature = sourceLayer.getFeature(i);
-        if (!leader.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+        const GeometryTileFeature& feature = sourceLayer.makeFeature(i, arena);
+        if (!leader.filter(feature.getType(), feature.getID(), [&] (const auto& key) { return keys.getValue(feature, key); }))
             continue;
         
-        SymbolFeature ft(std::move(feature));
+        SymbolFeature ft(feature, &keys);
 
         ft.index = i;
 
+        // Tokens are parsed for each feature, so their keys are looked up on the feature.
         auto getValue = [&ft](const std::string& key) -> std::string {
-            auto value = ft.getValue(key);
+            auto value = ft.feature->lookupValue(key);
             if (!value)
                 return std::string();
             if (value->is<std::string>())
@@ -182,7 +188,8 @@ bool SymbolLayout::canPrepare(GlyphAtlas& glyphAtlas) {
 }
 
 void SymbolLayout::prepare(uintptr_t tileUID,
-                           GlyphAtlas& glyphAtlas) {
+                           GlyphAtlas& glyphAtlas,
+                           util::MonotonicArena& arena) {
     float horizontalAlign = 0.5;
     float verticalAlign = 0.5;
 
@@ -253,11 +260,12 @@ void SymbolLayout::prepare(uintptr_t tileUID,
                     /* translate */ Point<float>(layout.get<TextOffset>()[0], layout.get<TextOffset>()[1]),
                     /* verticalHeight */ oneEm,
                     /* writingMode */ writingMode,
-                    /* bidirectional algorithm object */ bidi);
+                    /* bidirectional algorithm object */ bidi,
+                    /* temporaries of line breaking */ arena);
 
                 // Add the glyphs we need for this label to the glyph atlas.
                 if (result) {
-                    glyphAtlas.addGlyphs(tileUID, text, layout.get<TextFont>(), glyphSet, face);
+                    glyphAtlas.addGlyphs(tileUID, text, layout.get<TextFont>(), *glyphSet, face);
                 }
 
                 return result;
@@ -324,7 +332,7 @@ void SymbolLayout::addFeature(const std::size_t index,
                                                   ? SymbolPlacementType::Point
                                                   : layout.get<SymbolPlacement>();
     const float textRepeatDistance = symbolSpacing / 2;
-    IndexedSubfeature indexedFeature = {feature.index, sourceLayerName, bucketName, symbolInstances.size()};
+    IndexedSubfeature indexedFeature = { uint32_t(feature.index), sourceLayerName, bucketName, uint32_t(symbolInstances.size()) };
 
     auto addSymbolInstance = [&] (const GeometryCoordinates& line, Anchor& anchor) {
         // https://github.com/mapbox/vector-tile-spec/tree/master/2.1#41-layers
@@ -20,6 +20,11 @@ class SpriteAtlas;
 class GlyphAtlas;
 class SymbolBucket;
 class Anchor;
+class FeatureIndex;
+
+namespace util {
+class MonotonicArena;
+} // namespace util
 
 namespace style {
 class BucketParameters;
@@ -32,12 +37,15 @@ public:
     SymbolLayout(const style::BucketParameters&,
                  const std::vector<const style::Layer*>&,
                  const GeometryTileLayer&,
+                 FeatureIndex&,
+                 util::MonotonicArena&,
                  SpriteAtlas&);
 
     bool canPrepare(GlyphAtlas&);
 
     void prepare(uintptr_t tileUID,
-                 GlyphAtlas&);
+                 GlyphAtlas&,
+                 util::MonotonicArena&);
 
     std::unique_ptr<SymbolBucket> place(CollisionTile&);
 
@@ -72,8 +80,9 @@ private:
                     const bool keepUpright, const style::SymbolPlacementType, const float placementAngle,
                     WritingModeType writingModes);
 
-    const std::string sourceLayerName;
-    const std::string bucketName;
+    // Indices into the tile's FeatureIndex name table.
+    const uint16_t sourceLayerName;
+    const uint16_t bucketName;
     const float overscaling;
     const float zoom;
     const MapMode mode;
@@ -91,6 +100,7 @@ private:
 
     GlyphRangeSet ranges;
     std::vector<SymbolInstance> symbolInstances;
+    GeometryTileLayerKeys keys;
     std::vector<SymbolFeature> features;
 
     BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
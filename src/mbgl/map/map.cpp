@@ -97,6 +97,7 @@ public:
     std::unique_ptr<AsyncRequest> styleRequest;
 
     size_t sourceCacheSize;
+    bool parallelTileLayout = false;
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
@@ -348,7 +349,8 @@ void Map::setStyleURL(const std::string& url) {
     impl->styleJSON.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
+    impl->style->parallelLayout = impl->parallelTileLayout;
 
     impl->styleRequest = impl->fileSource.request(Resource::style(impl->styleURL), [this](Response res) {
         // Once we get a fresh style, or the style is mutated, stop revalidating.
@@ -391,7 +393,8 @@ void Map::setStyleJSON(const std::string& json) {
     impl->styleJSON.clear();
     impl->styleMutated = false;
 
-    impl->style = std::make_unique<Style>(impl->fileSource, impl->pixelRatio);
+    impl->style = std::make_unique<Style>(impl->scheduler, impl->fileSource, impl->pixelRatio);
+    impl->style->parallelLayout = impl->parallelTileLayout;
 
     impl->loadStyleJSON(json);
 }
@@ -1085,6 +1088,17 @@ void Map::onLowMemory() {
     }
 }
 
+void Map::setParallelTileLayout(bool enabled) {
+    impl->parallelTileLayout = enabled;
+    if (impl->style) {
+        impl->style->parallelLayout = enabled;
+    }
+}
+
+bool Map::getParallelTileLayout() const {
+    return impl->parallelTileLayout;
+}
+
 void Map::Impl::onSourceAttributionChanged(style::Source&, const std::string&) {
     backend.notifyMapChange(MapChangeSourceDidChange);
 }
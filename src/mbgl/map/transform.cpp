@@ -136,7 +136,8 @@ void Transform::easeTo(const CameraOptions& camera, const AnimationOptions& anim
     const double startPitch = state.pitch;
     state.panning = latLng != startLatLng;
     state.scaling = scale != startScale;
-    state.rotating = angle != startAngle;
+    // Tilting turns the map about its horizontal axis.
+    state.rotating = angle != startAngle || pitch != startPitch;
 
     startTransition(camera, animation, [=](double t) {
         Point<double> framePoint = util::interpolate(startPoint, endPoint, t);
@@ -25,8 +25,18 @@ public:
     Bucket() = default;
     virtual ~Bucket() = default;
 
-    virtual void addFeature(const GeometryTileFeature&,
-                            const GeometryCollection&) {};
+    // Features are added one line or ring at a time, followed by finishFeature(). The
+    // coordinates passed to addGeometry() are only valid for the duration of the call, so
+    // that tile workers can decode each line into the same buffer.
+    virtual void addGeometry(const GeometryCoordinates&) {};
+    virtual void finishFeature(const GeometryTileFeature&) {};
+
+    void addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometry) {
+        for (const auto& line : geometry) {
+            addGeometry(line);
+        }
+        finishFeature(feature);
+    }
 
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
     // this only happens once when the bucket is being rendered for the first time.
@@ -19,8 +19,8 @@ class CircleBucket : public Bucket {
 public:
     CircleBucket(const style::BucketParameters&, const std::vector<const style::Layer*>&);
 
-    void addFeature(const GeometryTileFeature&,
-                    const GeometryCollection&) override;
+    void addGeometry(const GeometryCoordinates&) override;
+    void finishFeature(const GeometryTileFeature&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
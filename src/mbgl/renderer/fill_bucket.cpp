@@ -36,77 +36,134 @@ FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<con
     }
 }
 
-void FillBucket::addFeature(const GeometryTileFeature& feature,
-                            const GeometryCollection& geometry) {
-    for (auto& polygon : classifyRings(geometry)) {
-        // Optimize polygons with many interior rings for earcut tesselation.
-        limitHoles(polygon, 500);
-
-        std::size_t totalVertices = 0;
-
-        for (const auto& ring : polygon) {
-            totalVertices += ring.size();
-            if (totalVertices > std::numeric_limits<uint16_t>::max())
-                throw GeometryTooLongException();
+void FillBucket::addGeometry(const GeometryCoordinates& ring) {
+    // Rings are grouped into polygons the way classifyRings() does it: a ring with the winding
+    // order of the feature's first ring starts a new polygon, and the others are its holes.
+    if (ringCount++ == 1 && ccw == 0) {
+        // The first ring has no area and isn't the only one.
+        clearPolygon();
+    }
+
+    const double area = signedArea(ring);
+
+    if (area == 0) {
+        if (ringCount == 1) {
+            addRing(ring);
         }
+        return;
+    }
 
-        std::size_t startVertices = vertices.vertexSize();
+    const int8_t orientation = area < 0 ? -1 : 1;
 
-        for (const auto& ring : polygon) {
-            std::size_t nVertices = ring.size();
+    if (ccw == 0) {
+        ccw = orientation;
+    } else if (ccw == orientation) {
+        addPolygon();
+    }
 
-            if (nVertices == 0)
-                continue;
+    addRing(ring);
+}
 
-            if (lineSegments.empty() || lineSegments.back().vertexLength + nVertices > std::numeric_limits<uint16_t>::max()) {
-                lineSegments.emplace_back(vertices.vertexSize(), lines.indexSize());
-            }
+void FillBucket::finishFeature(const GeometryTileFeature& feature) {
+    if (!polygon.empty()) {
+        addPolygon();
+    }
 
-            auto& lineSegment = lineSegments.back();
-            assert(lineSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
-            uint16_t lineIndex = lineSegment.vertexLength;
+    ringCount = 0;
+    ccw = 0;
 
-            vertices.emplace_back(FillProgram::layoutVertex(ring[0]));
-            lines.emplace_back(lineIndex + nVertices - 1, lineIndex);
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+    }
+}
 
-            for (uint32_t i = 1; i < nVertices; i++) {
-                vertices.emplace_back(FillProgram::layoutVertex(ring[i]));
-                lines.emplace_back(lineIndex + i - 1, lineIndex + i);
-            }
+void FillBucket::addRing(const GeometryCoordinates& ring) {
+    // Reuse the storage of rings of previous polygons.
+    if (spareRings.empty()) {
+        polygon.push_back(ring);
+    } else {
+        spareRings.back().assign(ring.begin(), ring.end());
+        polygon.push_back(std::move(spareRings.back()));
+        spareRings.pop_back();
+    }
+}
 
-            lineSegment.vertexLength += nVertices;
-            lineSegment.indexLength += nVertices * 2;
-        }
+void FillBucket::clearPolygon() {
+    for (auto& ring : polygon) {
+        spareRings.push_back(std::move(ring));
+    }
+    polygon.clear();
+}
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+void FillBucket::addPolygon() {
+    // Optimize polygons with many interior rings for earcut tesselation.
+    limitHoles(polygon, 500);
 
-        std::size_t nIndicies = indices.size();
-        assert(nIndicies % 3 == 0);
+    std::size_t totalVertices = 0;
 
-        if (triangleSegments.empty() || triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
-            triangleSegments.emplace_back(startVertices, triangles.indexSize());
+    for (const auto& ring : polygon) {
+        totalVertices += ring.size();
+        if (totalVertices > std::numeric_limits<uint16_t>::max())
+            throw GeometryTooLongException();
+    }
+
+    std::size_t startVertices = vertices.vertexSize();
+
+    for (const auto& ring : polygon) {
+        std::size_t nVertices = ring.size();
+
+        if (nVertices == 0)
+            continue;
+
+        if (lineSegments.empty() || lineSegments.back().vertexLength + nVertices > std::numeric_limits<uint16_t>::max()) {
+            lineSegments.emplace_back(vertices.vertexSize(), lines.indexSize());
         }
 
-        auto& triangleSegment = triangleSegments.back();
-        assert(triangleSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
-        uint16_t triangleIndex = triangleSegment.vertexLength;
+        auto& lineSegment = lineSegments.back();
+        assert(lineSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
+        uint16_t lineIndex = lineSegment.vertexLength;
+
+        vertices.emplace_back(FillProgram::layoutVertex(ring[0]));
+        lines.emplace_back(lineIndex + nVertices - 1, lineIndex);
 
-        for (uint32_t i = 0; i < nIndicies; i += 3) {
-            triangles.emplace_back(triangleIndex + indices[i],
-                                   triangleIndex + indices[i + 1],
-                                   triangleIndex + indices[i + 2]);
+        for (uint32_t i = 1; i < nVertices; i++) {
+            vertices.emplace_back(FillProgram::layoutVertex(ring[i]));
+            lines.emplace_back(lineIndex + i - 1, lineIndex + i);
         }
 
-        triangleSegment.vertexLength += totalVertices;
-        triangleSegment.indexLength += nIndicies;
+        lineSegment.vertexLength += nVertices;
+        lineSegment.indexLength += nVertices * 2;
     }
 
-    for (auto& pair : paintPropertyBinders) {
-        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+    std::vector<uint32_t> indices = mapbox::earcut(polygon);
+
+    std::size_t nIndicies = indices.size();
+    assert(nIndicies % 3 == 0);
+
+    if (triangleSegments.empty() || triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
+        triangleSegments.emplace_back(startVertices, triangles.indexSize());
+    }
+
+    auto& triangleSegment = triangleSegments.back();
+    assert(triangleSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
+    uint16_t triangleIndex = triangleSegment.vertexLength;
+
+    for (uint32_t i = 0; i < nIndicies; i += 3) {
+        triangles.emplace_back(triangleIndex + indices[i],
+                               triangleIndex + indices[i + 1],
+                               triangleIndex + indices[i + 2]);
     }
+
+    triangleSegment.vertexLength += totalVertices;
+    triangleSegment.indexLength += nIndicies;
+
+    clearPolygon();
 }
 
 void FillBucket::upload(gl::Context& context) {
+    polygon = {};
+    spareRings = {};
+
     vertexBuffer = context.createVertexBuffer(std::move(vertices));
     lineIndexBuffer = context.createIndexBuffer(std::move(lines));
     triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
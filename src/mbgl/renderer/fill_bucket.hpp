@@ -20,8 +20,8 @@ class FillBucket : public Bucket {
 public:
     FillBucket(const style::BucketParameters&, const std::vector<const style::Layer*>&);
 
-    void addFeature(const GeometryTileFeature&,
-                    const GeometryCollection&) override;
+    void addGeometry(const GeometryCoordinates&) override;
+    void finishFeature(const GeometryTileFeature&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
@@ -38,6 +38,17 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
 
     std::unordered_map<std::string, FillProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    void addRing(const GeometryCoordinates&);
+    void clearPolygon();
+    void addPolygon();
+
+    // Rings of the polygon that is being added, and the storage of earlier rings for reuse.
+    GeometryCollection polygon;
+    std::vector<GeometryCoordinates> spareRings;
+    std::size_t ringCount = 0;
+    int8_t ccw = 0;
 };
 
 } // namespace mbgl
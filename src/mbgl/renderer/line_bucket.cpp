@@ -25,12 +25,7 @@ LineBucket::LineBucket(const BucketParameters& parameters,
     }
 }
 
-void LineBucket::addFeature(const GeometryTileFeature& feature,
-                            const GeometryCollection& geometryCollection) {
-    for (auto& line : geometryCollection) {
-        addGeometry(line);
-    }
-
+void LineBucket::finishFeature(const GeometryTileFeature& feature) {
     for (auto& pair : paintPropertyBinders) {
         pair.second.populateVertexVectors(feature, vertices.vertexSize());
     }
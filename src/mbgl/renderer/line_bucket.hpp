@@ -22,8 +22,8 @@ public:
                const std::vector<const style::Layer*>&,
                const style::LineLayoutProperties&);
 
-    void addFeature(const GeometryTileFeature&,
-                    const GeometryCollection&) override;
+    void addGeometry(const GeometryCoordinates&) override;
+    void finishFeature(const GeometryTileFeature&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
@@ -41,8 +41,6 @@ public:
     std::unordered_map<std::string, LineProgram::PaintPropertyBinders> paintPropertyBinders;
 
 private:
-    void addGeometry(const GeometryCoordinates& line);
-
     struct TriangleElement {
         TriangleElement(uint16_t a_, uint16_t b_, uint16_t c_) : a(a_), b(b_), c(c_) {}
         uint16_t a, b, c;
@@ -0,0 +1,577 @@
+#include <mbgl/style/conversion/geojson_reader.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+namespace {
+
+using Geometry = mapbox::geometry::geometry<double>;
+using Position = mapbox::geometry::point<double>;
+
+// The coordinates of a geometry, collected before its type is necessarily known: "type" may
+// follow "coordinates". Positions are stored in one flat array. For every array nesting
+// depth, `ends` records where each array ended, as the number of arrays one level deeper (or
+// positions) that had been completed at that point.
+class Coordinates {
+public:
+    // MultiPolygon coordinates are the most deeply nested.
+    static constexpr std::size_t maxDepth = 4;
+
+    bool startArray() {
+        if (positionSize > 0 || depth == maxDepth) {
+            return false;
+        }
+        deepest = std::max(deepest, ++depth);
+        return true;
+    }
+
+    bool number(double value) {
+        if (positionSize < 2) {
+            xy[positionSize] = value;
+        }
+        // Altitude and other additional elements are ignored.
+        positionSize++;
+        return true;
+    }
+
+    bool endArray() {
+        if (positionSize > 0) {
+            if (positionSize < 2 || (positionDepth != 0 && positionDepth != depth)) {
+                return false;
+            }
+            positionDepth = depth;
+            positions.push_back({ xy[0], xy[1] });
+            positionSize = 0;
+        } else {
+            ends[depth].push_back(closed[depth + 1]);
+            empty[depth] = true;
+        }
+        closed[depth]++;
+        depth--;
+        return true;
+    }
+
+    bool isComplete() const {
+        return depth == 0;
+    }
+
+    // Builds a geometry of the given type, or returns nothing if the coordinates don't fit it.
+    optional<Geometry> toGeometry(const std::string& type) const {
+        if (type == "Point") {
+            if (!matches(1) || positions.size() != 1) {
+                return {};
+            }
+            return Geometry { positions.front() };
+        } else if (type == "MultiPoint") {
+            if (!matches(2)) {
+                return {};
+            }
+            return Geometry { slice<mapbox::geometry::multi_point<double>>(0, positions.size()) };
+        } else if (type == "LineString") {
+            if (!matches(2)) {
+                return {};
+            }
+            return Geometry { slice<mapbox::geometry::line_string<double>>(0, positions.size()) };
+        } else if (type == "MultiLineString") {
+            if (!matches(3)) {
+                return {};
+            }
+            return Geometry { lines<mapbox::geometry::multi_line_string<double>>(2, 0, ends[2].size()) };
+        } else if (type == "Polygon") {
+            if (!matches(3)) {
+                return {};
+            }
+            return Geometry { lines<mapbox::geometry::polygon<double>>(2, 0, ends[2].size()) };
+        } else if (type == "MultiPolygon") {
+            if (!matches(4)) {
+                return {};
+            }
+            mapbox::geometry::multi_polygon<double> result;
+            result.reserve(ends[2].size());
+            for (std::size_t i = 0; i < ends[2].size(); ++i) {
+                result.push_back(lines<mapbox::geometry::polygon<double>>(3, i == 0 ? 0 : ends[2][i - 1], ends[2][i]));
+            }
+            return Geometry { std::move(result) };
+        }
+        return {};
+    }
+
+private:
+    // Whether positions, if any, are nested `expected` arrays deep. Empty arrays are fine,
+    // except in place of a position.
+    bool matches(std::size_t expected) const {
+        return deepest <= expected && !empty[expected] &&
+            (positionDepth == 0 || positionDepth == expected);
+    }
+
+    template <class Line>
+    Line slice(std::size_t begin, std::size_t end) const {
+        Line line;
+        line.reserve(end - begin);
+        line.insert(line.end(), positions.begin() + begin, positions.begin() + end);
+        return line;
+    }
+
+    // The lines in the range [begin, end) of the arrays at the given depth.
+    template <class Lines>
+    Lines lines(std::size_t lineDepth, std::size_t begin, std::size_t end) const {
+        Lines result;
+        result.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& lineEnds = ends[lineDepth];
+            result.push_back(slice<typename Lines::value_type>(i == 0 ? 0 : lineEnds[i - 1], lineEnds[i]));
+        }
+        return result;
+    }
+
+    std::vector<Position> positions;
+    std::array<std::vector<std::size_t>, maxDepth + 1> ends;
+    std::array<std::size_t, maxDepth + 2> closed {};
+    std::array<bool, maxDepth + 1> empty {};
+
+    std::size_t depth = 0;
+    std::size_t deepest = 0;
+    std::size_t positionDepth = 0;
+
+    std::array<double, 2> xy {};
+    std::size_t positionSize = 0;
+};
+
+enum class Member {
+    Other,
+    Type,
+    ID,
+    Coordinates,
+    Geometry,
+    Geometries,
+    Features,
+    Properties
+};
+
+// A GeoJSON object whose members are being read.
+struct Object {
+    Member member = Member::Other;
+
+    optional<std::string> type;
+
+    // Geometry
+    optional<Coordinates> coordinates;
+    optional<mapbox::geometry::geometry_collection<double>> geometries;
+
+    // Feature
+    optional<Geometry> geometry;
+    PropertyMap properties;
+    optional<FeatureIdentifier> id;
+
+    // FeatureCollection
+    optional<FeatureCollection> features;
+};
+
+// A JSON array or object inside of "properties".
+struct Container {
+    bool isArray;
+    std::vector<Value> array;
+    PropertyMap object;
+    std::string key;
+};
+
+class Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+public:
+    optional<GeoJSON> result;
+    optional<std::string> error;
+
+    bool Null() {
+        return scalar(NullValue());
+    }
+
+    bool Bool(bool value) {
+        return scalar(value);
+    }
+
+    bool Int(int value) {
+        return number(int64_t(value));
+    }
+
+    bool Uint(unsigned value) {
+        return number(uint64_t(value));
+    }
+
+    bool Int64(int64_t value) {
+        return number(value);
+    }
+
+    bool Uint64(uint64_t value) {
+        return number(value);
+    }
+
+    bool Double(double value) {
+        return number(value);
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+        return scalar(std::string(str, length));
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        switch (top()) {
+        case State::Skip:
+            return true;
+        case State::Container:
+            containers.back().key.assign(str, length);
+            return true;
+        case State::Object:
+            objects.back().member = memberForKey(std::string(str, length));
+            return true;
+        default:
+            return fail("unexpected key");
+        }
+    }
+
+    bool StartObject() {
+        switch (top()) {
+        case State::None:
+        case State::Features:
+        case State::Geometries:
+            return startObject();
+        case State::Skip:
+            states.push_back(State::Skip);
+            return true;
+        case State::Container:
+            return startContainer(false);
+        case State::Object:
+            switch (objects.back().member) {
+            case Member::Geometry:
+                return startObject();
+            case Member::Properties:
+                return startContainer(false);
+            case Member::Other:
+                states.push_back(State::Skip);
+                return true;
+            default:
+                return fail("unexpected object");
+            }
+        default:
+            return fail("unexpected object");
+        }
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        switch (top()) {
+        case State::Skip:
+            states.pop_back();
+            return true;
+        case State::Container:
+            return endContainer();
+        case State::Object:
+            return endObject();
+        default:
+            return fail("unexpected end of object");
+        }
+    }
+
+    bool StartArray() {
+        switch (top()) {
+        case State::Skip:
+            states.push_back(State::Skip);
+            return true;
+        case State::Container:
+            return startContainer(true);
+        case State::Coordinates:
+            return objects.back().coordinates->startArray() || fail("invalid coordinates");
+        case State::Object: {
+            Object& object = objects.back();
+            switch (object.member) {
+            case Member::Coordinates:
+                object.coordinates.emplace();
+                states.push_back(State::Coordinates);
+                return object.coordinates->startArray();
+            case Member::Geometries:
+                object.geometries.emplace();
+                states.push_back(State::Geometries);
+                return true;
+            case Member::Features:
+                object.features.emplace();
+                states.push_back(State::Features);
+                return true;
+            case Member::Other:
+                states.push_back(State::Skip);
+                return true;
+            default:
+                return fail("unexpected array");
+            }
+        }
+        default:
+            return fail("unexpected array");
+        }
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        switch (top()) {
+        case State::Skip:
+        case State::Features:
+        case State::Geometries:
+            states.pop_back();
+            return true;
+        case State::Container:
+            return endContainer();
+        case State::Coordinates: {
+            Coordinates& coordinates = *objects.back().coordinates;
+            if (!coordinates.endArray()) {
+                return fail("invalid coordinates");
+            }
+            if (coordinates.isComplete()) {
+                states.pop_back();
+            }
+            return true;
+        }
+        default:
+            return fail("unexpected end of array");
+        }
+    }
+
+private:
+    enum class State {
+        None,
+        Object,
+        Features,
+        Geometries,
+        Coordinates,
+        Container,
+        Skip
+    };
+
+    State top() const {
+        return states.empty() ? State::None : states.back();
+    }
+
+    bool fail(const char* message) {
+        error = std::string(message);
+        return false;
+    }
+
+    static Member memberForKey(const std::string& key) {
+        if (key == "type") return Member::Type;
+        if (key == "id") return Member::ID;
+        if (key == "coordinates") return Member::Coordinates;
+        if (key == "geometry") return Member::Geometry;
+        if (key == "geometries") return Member::Geometries;
+        if (key == "features") return Member::Features;
+        if (key == "properties") return Member::Properties;
+        return Member::Other;
+    }
+
+    template <class T>
+    bool number(T value) {
+        if (top() == State::Coordinates) {
+            return objects.back().coordinates->number(double(value));
+        }
+        return scalar(value);
+    }
+
+    bool scalar(Value value) {
+        switch (top()) {
+        case State::Skip:
+            return true;
+        case State::Container:
+            return add(std::move(value));
+        case State::Object:
+            return member(std::move(value));
+        default:
+            return fail("unexpected value");
+        }
+    }
+
+    // A scalar member of a GeoJSON object.
+    bool member(Value value) {
+        Object& object = objects.back();
+        switch (object.member) {
+        case Member::Type:
+            if (!value.is<std::string>()) {
+                return fail("type must be a string");
+            }
+            object.type = std::move(value.get<std::string>());
+            return true;
+        case Member::ID:
+            if (value.is<uint64_t>()) {
+                object.id = FeatureIdentifier { value.get<uint64_t>() };
+            } else if (value.is<int64_t>()) {
+                object.id = FeatureIdentifier { value.get<int64_t>() };
+            } else if (value.is<double>()) {
+                object.id = FeatureIdentifier { value.get<double>() };
+            } else if (value.is<std::string>()) {
+                object.id = FeatureIdentifier { std::move(value.get<std::string>()) };
+            } else if (!value.is<NullValue>()) {
+                return fail("id must be a string or a number");
+            }
+            return true;
+        case Member::Geometry:
+            if (!value.is<NullValue>()) {
+                return fail("geometry must be an object or null");
+            }
+            object.geometry = Geometry { mapbox::geometry::geometry_collection<double>() };
+            return true;
+        case Member::Properties:
+            if (!value.is<NullValue>()) {
+                return fail("properties must be an object or null");
+            }
+            return true;
+        case Member::Other:
+            return true;
+        default:
+            return fail("unexpected value");
+        }
+    }
+
+    bool startObject() {
+        objects.emplace_back();
+        states.push_back(State::Object);
+        return true;
+    }
+
+    bool endObject() {
+        Object object = std::move(objects.back());
+        objects.pop_back();
+        states.pop_back();
+
+        if (!object.type) {
+            return fail("GeoJSON object must have a type");
+        }
+
+        const std::string& type = *object.type;
+        if (type == "FeatureCollection") {
+            if (!object.features) {
+                return fail("FeatureCollection must have features");
+            }
+            return deliver(GeoJSON { std::move(*object.features) });
+        } else if (type == "Feature") {
+            if (!object.geometry) {
+                return fail("Feature must have a geometry");
+            }
+            Feature feature { std::move(*object.geometry), std::move(object.properties), std::move(object.id) };
+            return deliver(GeoJSON { std::move(feature) });
+        } else if (type == "GeometryCollection") {
+            if (!object.geometries) {
+                return fail("GeometryCollection must have geometries");
+            }
+            return deliver(GeoJSON { Geometry { std::move(*object.geometries) } });
+        } else {
+            if (!object.coordinates) {
+                return fail("geometry must have coordinates");
+            }
+            optional<Geometry> geometry = object.coordinates->toGeometry(type);
+            if (!geometry) {
+                return fail("invalid geometry");
+            }
+            return deliver(GeoJSON { std::move(*geometry) });
+        }
+    }
+
+    // Hands a completed GeoJSON object to the object or array containing it.
+    bool deliver(GeoJSON geoJSON) {
+        switch (top()) {
+        case State::None:
+            result = std::move(geoJSON);
+            return true;
+        case State::Features:
+            if (!geoJSON.is<Feature>()) {
+                return fail("FeatureCollection must only contain Features");
+            }
+            objects.back().features->push_back(std::move(geoJSON.get<Feature>()));
+            return true;
+        case State::Geometries:
+            if (!geoJSON.is<Geometry>()) {
+                return fail("GeometryCollection must only contain geometries");
+            }
+            objects.back().geometries->push_back(std::move(geoJSON.get<Geometry>()));
+            return true;
+        case State::Object:
+            if (!geoJSON.is<Geometry>()) {
+                return fail("geometry must be a geometry");
+            }
+            objects.back().geometry = std::move(geoJSON.get<Geometry>());
+            return true;
+        default:
+            return fail("unexpected object");
+        }
+    }
+
+    bool startContainer(bool isArray) {
+        containers.push_back(Container { isArray, {}, {}, {} });
+        states.push_back(State::Container);
+        return true;
+    }
+
+    bool endContainer() {
+        Container container = std::move(containers.back());
+        containers.pop_back();
+        states.pop_back();
+
+        if (top() == State::Object) {
+            // The "properties" member of a Feature.
+            objects.back().properties = std::move(container.object);
+            return true;
+        }
+
+        if (container.isArray) {
+            return add(Value { std::move(container.array) });
+        } else {
+            return add(Value { std::move(container.object) });
+        }
+    }
+
+    bool add(Value value) {
+        Container& container = containers.back();
+        if (container.isArray) {
+            container.array.push_back(std::move(value));
+        } else {
+            container.object[container.key] = std::move(value);
+        }
+        return true;
+    }
+
+    std::vector<State> states;
+    std::vector<Object> objects;
+    std::vector<Container> containers;
+};
+
+} // namespace
+
+Result<GeoJSON> parseGeoJSON(const std::string& json) {
+    Handler handler;
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(json.c_str());
+    reader.Parse(stream, handler);
+
+    if (handler.error) {
+        return Error { *handler.error };
+    }
+
+    if (reader.HasParseError()) {
+        std::stringstream message;
+        message << reader.GetErrorOffset() << " - "
+                << rapidjson::GetParseError_En(reader.GetParseError());
+        throw std::runtime_error(message.str());
+    }
+
+    if (!handler.result) {
+        return Error { "GeoJSON must be an object" };
+    }
+
+    return std::move(*handler.result);
+}
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
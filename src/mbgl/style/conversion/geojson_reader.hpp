@@ -0,0 +1,19 @@
+#pragma once
+
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+// Parses GeoJSON text into features with a streaming (SAX) parser, without building a JSON
+// document first. Returns an Error if `json` is valid JSON, but not valid GeoJSON. Throws
+// std::runtime_error if `json` isn't valid JSON.
+Result<GeoJSON> parseGeoJSON(const std::string& json);
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
@@ -3,11 +3,13 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/property_value.hpp>
 #include <mbgl/style/layout_property.hpp>
+#include <mbgl/style/possibly_evaluated_property_value.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/color.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/ignore.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/type_list.hpp>
 
 #include <array>
 #include <vector>
@@ -453,6 +455,17 @@ void stringify(Writer& writer, const LayoutProperties<Ps...>& ps) {
     writer.EndObject();
 }
 
+// Writes the functions of evaluated data-driven paint properties, which buckets bake into their
+// vertex data. Constant values are read from the layer at render time, so they're left out.
+template <class Writer, class Evaluated, class... Ps>
+void stringifyDataDriven(Writer& writer, const Evaluated& evaluated, TypeList<Ps...>) {
+    writer.StartArray();
+    util::ignore({ (evaluated.template get<Ps>().match(
+        [&] (const typename Ps::Type&) { writer.Null(); },
+        [&] (const auto& function) { stringify(writer, function); }), 0)... });
+    writer.EndArray();
+}
+
 } // namespace conversion
 } // namespace style
 } // namespace mbgl
@@ -7,6 +7,7 @@
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace mbgl {
@@ -46,5 +47,26 @@ std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::uniq
     return result;
 }
 
+std::string bucketKey(const std::vector<const Layer*>& group) {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+    writer.StartArray();
+    writer.String(layoutKey(*group.at(0)));
+    for (const auto& layer : group) {
+        writer.String(layer->baseImpl->id);
+        layer->baseImpl->stringifyBucketPaint(writer);
+    }
+    writer.EndArray();
+
+    return s.GetString();
+}
+
+bool bucketDependsOnOverscaledZoom(const std::vector<const Layer*>& group) {
+    return std::any_of(group.begin(), group.end(), [] (const Layer* layer) {
+        return layer->baseImpl->bucketDependsOnOverscaledZoom();
+    });
+}
+
 } // namespace style
 } // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 namespace style {
@@ -10,5 +11,13 @@ class Layer;
 
 std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
 
+// Identifies the bucket that a group of layers is laid out into: groups with the same key
+// produce the same bucket from the same tile data.
+std::string bucketKey(const std::vector<const Layer*>& group);
+
+// Whether the bucket of a group depends on the overscaled zoom level of its tile. Buckets
+// hold paint property binders for every layer of the group, so any of them may require it.
+bool bucketDependsOnOverscaledZoom(const std::vector<const Layer*>& group);
+
 } // namespace style
 } // namespace mbgl
@@ -54,6 +54,14 @@ public:
     // Utility function for automatic layer grouping.
     virtual void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const = 0;
 
+    // Utility function for keeping buckets across layouts: writes the paint properties that
+    // buckets are built from.
+    virtual void stringifyBucketPaint(rapidjson::Writer<rapidjson::StringBuffer>&) const {}
+
+    // Whether buckets depend on the overscaled zoom level of their tile, rather than only
+    // on the canonical tile data. Buckets that don't are shared between overscaled tiles.
+    virtual bool bucketDependsOnOverscaledZoom() const { return true; }
+
     // Partially evaluate paint properties based on a set of classes.
     virtual void cascade(const CascadeParameters&) = 0;
 
@@ -1,4 +1,5 @@
 #include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/conversion/stringify.hpp>
 #include <mbgl/renderer/circle_bucket.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/util/math.hpp>
@@ -25,6 +26,14 @@ bool CircleLayer::Impl::evaluate(const PropertyEvaluationParameters& parameters)
     return paint.hasTransition();
 }
 
+void CircleLayer::Impl::stringifyBucketPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringifyDataDriven(writer, paint.evaluated, CirclePaintProperties::DataDrivenProperties());
+}
+
+bool CircleLayer::Impl::bucketDependsOnOverscaledZoom() const {
+    return paint.hasCompositeFunction();
+}
+
 std::unique_ptr<Bucket> CircleLayer::Impl::createBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) const {
     return std::make_unique<CircleBucket>(parameters, layers);
 }
@@ -12,6 +12,8 @@ public:
     std::unique_ptr<Layer> clone() const override;
     std::unique_ptr<Layer> cloneRef(const std::string& id) const override;
     void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
+    void stringifyBucketPaint(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
+    bool bucketDependsOnOverscaledZoom() const override;
 
     void cascade(const CascadeParameters&) override;
     bool evaluate(const PropertyEvaluationParameters&) override;
@@ -1,4 +1,5 @@
 #include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/conversion/stringify.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/util/math.hpp>
@@ -35,6 +36,14 @@ bool FillLayer::Impl::evaluate(const PropertyEvaluationParameters& parameters) {
     return paint.hasTransition();
 }
 
+void FillLayer::Impl::stringifyBucketPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringifyDataDriven(writer, paint.evaluated, FillPaintProperties::DataDrivenProperties());
+}
+
+bool FillLayer::Impl::bucketDependsOnOverscaledZoom() const {
+    return paint.hasCompositeFunction();
+}
+
 std::unique_ptr<Bucket> FillLayer::Impl::createBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) const {
     return std::make_unique<FillBucket>(parameters, layers);
 }
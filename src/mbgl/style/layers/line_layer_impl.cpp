@@ -1,4 +1,5 @@
 #include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/style/conversion/stringify.hpp>
 #include <mbgl/style/property_evaluation_parameters.hpp>
 #include <mbgl/renderer/line_bucket.hpp>
 #include <mbgl/geometry/feature_index.hpp>
@@ -28,6 +29,10 @@ bool LineLayer::Impl::evaluate(const PropertyEvaluationParameters& parameters) {
     return paint.hasTransition();
 }
 
+void LineLayer::Impl::stringifyBucketPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringifyDataDriven(writer, paint.evaluated, LinePaintProperties::DataDrivenProperties());
+}
+
 std::unique_ptr<Bucket> LineLayer::Impl::createBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) const {
     return std::make_unique<LineBucket>(parameters, layers, layout);
 }
@@ -36,10 +36,14 @@ std::unique_ptr<Bucket> SymbolLayer::Impl::createBucket(const BucketParameters&,
 
 std::unique_ptr<SymbolLayout> SymbolLayer::Impl::createLayout(const BucketParameters& parameters,
                                                               const std::vector<const Layer*>& group,
-                                                              const GeometryTileLayer& layer) const {
+                                                              const GeometryTileLayer& layer,
+                                                              FeatureIndex& featureIndex,
+                                                              util::MonotonicArena& arena) const {
     return std::make_unique<SymbolLayout>(parameters,
                                           group,
                                           layer,
+                                          featureIndex,
+                                          arena,
                                           *spriteAtlas);
 }
 
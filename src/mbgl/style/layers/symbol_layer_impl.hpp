@@ -9,6 +9,11 @@ namespace mbgl {
 
 class SpriteAtlas;
 class SymbolLayout;
+class FeatureIndex;
+
+namespace util {
+class MonotonicArena;
+} // namespace util
 
 namespace style {
     
@@ -67,7 +72,7 @@ public:
 
     std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const Layer*>&) const override;
     std::unique_ptr<SymbolLayout> createLayout(const BucketParameters&, const std::vector<const Layer*>&,
-                                               const GeometryTileLayer&) const;
+                                               const GeometryTileLayer&, FeatureIndex&, util::MonotonicArena&) const;
 
     IconPaintProperties::Evaluated iconPaintProperties() const;
     TextPaintProperties::Evaluated textPaintProperties() const;
@@ -182,6 +182,18 @@ public:
 template <class P>
 struct IsDataDriven : std::integral_constant<bool, P::IsDataDriven> {};
 
+template <class T>
+bool isCompositeFunction(const PossiblyEvaluatedPropertyValue<T>& value) {
+    return value.match(
+        [] (const CompositeFunction<T>&) { return true; },
+        [] (const auto&) { return false; });
+}
+
+template <class T>
+bool isCompositeFunction(const T&) {
+    return false;
+}
+
 template <class... Ps>
 class PaintProperties {
 public:
@@ -252,6 +264,14 @@ public:
         return result;
     }
 
+    // Whether a data-driven property depends on zoom as well as on feature properties, in
+    // which case the binders of a bucket depend on the zoom level of its tile.
+    bool hasCompositeFunction() const {
+        bool result = false;
+        util::ignore({ result |= isCompositeFunction(evaluated.template get<Ps>())... });
+        return result;
+    }
+
     Cascading cascading;
     Unevaluated unevaluated;
     Evaluated evaluated;
@@ -8,6 +8,7 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/util/tile_cover.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/style/query.hpp>
@@ -19,6 +20,7 @@
 #include <mapbox/geometry/envelope.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 namespace style {
@@ -115,9 +117,31 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     // we're actively using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
-    auto retainTileFn = [&retain](Tile& tile, Resource::Necessity necessity) -> void {
+    // Required tiles around the center of the viewport are loaded and laid out first; optional
+    // tiles (e.g. lower zoom backfill) are laid out last.
+    const TileCoordinate center = TileCoordinate::fromLatLng(0, parameters.transformState.getLatLng(LatLng::Wrapped));
+    auto distanceFn = [&center](const OverscaledTileID& tileID) {
+        const double scale = std::pow(2.0, tileID.canonical.z);
+        const TileCoordinatePoint p = center.zoomTo(tileID.canonical.z).p;
+        const double dx = std::abs(p.x - (tileID.canonical.x + 0.5));
+        const double dy = std::abs(p.y - (tileID.canonical.y + 0.5));
+        return std::max(std::min(dx, scale - dx), dy);
+    };
+
+    auto retainTileFn = [&retain, &distanceFn](Tile& tile, Resource::Necessity necessity) -> void {
         retain.emplace(tile.id);
+
+        const double distance = distanceFn(tile.id);
+        // Set before the necessity, so that a request made for a newly required tile is
+        // queued with it.
+        tile.setRequestPriority(static_cast<uint32_t>(distance));
         tile.setNecessity(necessity);
+
+        if (necessity == Resource::Necessity::Optional) {
+            tile.setPriority(Scheduler::Priority::Low);
+        } else {
+            tile.setPriority(distance <= 1 ? Scheduler::Priority::High : Scheduler::Priority::Normal);
+        }
     };
     auto getTileFn = [this](const OverscaledTileID& tileID) -> Tile* {
         auto it = tiles.find(tileID);
@@ -159,8 +183,12 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
                                    parameters.transformState.getPitch(),
                                    parameters.debugOptions & MapDebugOptions::Collision };
 
+    // Still images are always placed exactly, so that the same camera gives the same labels.
+    const bool cameraIsMoving = parameters.mode == MapMode::Continuous &&
+                                parameters.transformState.isChanging();
+
     for (auto& pair : tiles) {
-        pair.second->setPlacementConfig(config);
+        pair.second->setPlacementConfig(config, cameraIsMoving);
     }
 }
 
@@ -173,6 +201,7 @@ void Source::Impl::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
     while (tilesIt != tiles.end()) {
         if (retainIt == retain.end() || tilesIt->first < *retainIt) {
             tilesIt->second->setNecessity(Tile::Necessity::Optional);
+            tilesIt->second->setPriority(Scheduler::Priority::Low);
             cache.add(tilesIt->first, std::move(tilesIt->second));
             tiles.erase(tilesIt++);
         } else {
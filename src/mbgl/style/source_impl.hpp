@@ -23,6 +23,7 @@ namespace mbgl {
 
 class Painter;
 class FileSource;
+class Scheduler;
 class TransformState;
 class RenderTile;
 class RenderedQueryOptions;
@@ -41,8 +42,8 @@ public:
     Impl(SourceType, std::string id, Source&);
     ~Impl() override;
 
-    virtual void loadDescription(FileSource&) = 0;
-    bool isLoaded() const;
+    virtual void loadDescription(FileSource&, Scheduler&) = 0;
+    virtual bool isLoaded() const;
 
     // Called when the camera has changed. May load new tiles, unload obsolete tiles, or
     // trigger re-placement of existing complete tiles.
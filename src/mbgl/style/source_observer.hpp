@@ -17,6 +17,8 @@ public:
     virtual ~SourceObserver() = default;
 
     virtual void onSourceLoaded(Source&) {}
+    // The data of a loaded source changed, e.g. after a GeoJSON update was indexed.
+    virtual void onSourceChanged(Source&) {}
     virtual void onSourceAttributionChanged(Source&, const std::string&) {}
     virtual void onSourceError(Source&, std::exception_ptr) {}
 
@@ -0,0 +1,153 @@
+#include <mbgl/style/sources/geojson_features.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/projection.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace mbgl {
+namespace style {
+
+void addWorldBounds(const mapbox::geometry::geometry<double>& geometry, GeoJSONChangedBounds& bounds) {
+    const auto envelope = mapbox::geometry::envelope(geometry);
+    if (envelope.min.x > envelope.max.x) {
+        return; // Empty geometry; doesn't intersect anything.
+    }
+
+    const auto project = [] (double lat, double lon) {
+        return Projection::project(LatLng(util::clamp(lat, -90.0, 90.0), lon), 1) / double(util::tileSize);
+    };
+
+    // Latitude increases northwards, world coordinates southwards.
+    mapbox::geometry::box<double> box { project(envelope.max.y, envelope.min.x),
+                                        project(envelope.min.y, envelope.max.x) };
+
+    if (box.max.x - box.min.x >= 1) {
+        bounds.push_back({ { 0, box.min.y }, { 1, box.max.y } });
+        return;
+    }
+
+    // Move the box into the world, and split off the part beyond the antimeridian.
+    const double shift = std::floor(box.min.x);
+    box.min.x -= shift;
+    box.max.x -= shift;
+
+    if (box.max.x <= 1) {
+        bounds.push_back(box);
+    } else {
+        bounds.push_back({ box.min, { 1, box.max.y } });
+        bounds.push_back({ { 0, box.min.y }, { box.max.x - 1, box.max.y } });
+    }
+}
+
+void GeoJSONFeatures::reset(GeoJSON geoJSON) {
+    features.clear();
+    indices.clear();
+
+    if (geoJSON.is<FeatureCollection>()) {
+        features = std::move(geoJSON.get<FeatureCollection>());
+    } else if (geoJSON.is<mapbox::geometry::feature<double>>()) {
+        features.push_back(std::move(geoJSON.get<mapbox::geometry::feature<double>>()));
+    } else {
+        features.push_back({ std::move(geoJSON.get<mapbox::geometry::geometry<double>>()) });
+    }
+
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (features[i].id) {
+            indices.emplace(*features[i].id, i);
+        }
+    }
+}
+
+GeoJSONChangedBounds GeoJSONFeatures::update(FeatureCollection upserts,
+                                             const std::vector<FeatureIdentifier>& removals) {
+    GeoJSONChangedBounds changed;
+
+    for (const auto& id : removals) {
+        auto range = indices.equal_range(id);
+
+        std::vector<std::size_t> positions;
+        for (auto it = range.first; it != range.second; ++it) {
+            positions.push_back(it->second);
+        }
+
+        indices.erase(range.first, range.second);
+        erase(std::move(positions), changed);
+    }
+
+    for (auto& feature : upserts) {
+        addWorldBounds(feature.geometry, changed);
+
+        if (feature.id) {
+            auto range = indices.equal_range(*feature.id);
+            if (range.first != range.second) {
+                // Replace the first feature with this identifier in place, so that it keeps its
+                // place in the drawing order, and remove all others.
+                const std::size_t i = range.first->second;
+                addWorldBounds(features[i].geometry, changed);
+                features[i] = std::move(feature);
+
+                std::vector<std::size_t> positions;
+                for (auto it = std::next(range.first); it != range.second; ++it) {
+                    positions.push_back(it->second);
+                }
+
+                indices.erase(std::next(range.first), range.second);
+                erase(std::move(positions), changed);
+                continue;
+            }
+
+            indices.emplace(*feature.id, features.size());
+        }
+
+        features.push_back(std::move(feature));
+    }
+
+    return changed;
+}
+
+// Removes the features at `positions`, which must no longer be in `indices`. The remaining
+// features keep their order, since it is the order they are drawn in: tiles that aren't sliced
+// again would otherwise draw overlapping features differently from their neighbours.
+void GeoJSONFeatures::erase(std::vector<std::size_t> positions, GeoJSONChangedBounds& changed) {
+    if (positions.empty()) {
+        return;
+    }
+
+    std::sort(positions.begin(), positions.end());
+    for (const std::size_t i : positions) {
+        addWorldBounds(features[i].geometry, changed);
+    }
+
+    // Shift the features that follow the first gap forward, and update their indices.
+    auto next = positions.begin();
+    std::size_t end = *next;
+    for (std::size_t i = end; i < features.size(); ++i) {
+        if (next != positions.end() && *next == i) {
+            ++next;
+            continue;
+        }
+
+        features[end] = std::move(features[i]);
+        if (features[end].id) {
+            auto range = indices.equal_range(*features[end].id);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == i) {
+                    it->second = end;
+                    break;
+                }
+            }
+        }
+        ++end;
+    }
+
+    features.erase(features.begin() + end, features.end());
+}
+
+} // namespace style
+} // namespace mbgl
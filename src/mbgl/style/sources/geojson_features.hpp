@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geojson.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <map>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+// Bounds of changed features, in world coordinates ([0, 1] on both axes at zoom 0).
+using GeoJSONChangedBounds = std::vector<mapbox::geometry::box<double>>;
+
+// Adds the world bounds of `geometry` to `bounds`. geojson-vt wraps geometries that extend past
+// the antimeridian around to the other side of the world, so bounds are split there as well.
+void addWorldBounds(const mapbox::geometry::geometry<double>&, GeoJSONChangedBounds&);
+
+// The features of a GeoJSONSource, indexed by identifier so that individual features can be
+// replaced or removed. Features that share an identifier are replaced or removed together.
+//
+// This is the only copy of the source's features that is kept: geojson-vt indexes them from a
+// const reference and only keeps its own projected and simplified tiles. Supercluster copies
+// the features it is given into the index, so clustered sources hold them twice.
+class GeoJSONFeatures {
+public:
+    void reset(GeoJSON);
+
+    // Adds or replaces the features in `upserts`, matched by identifier, and removes the
+    // features identified by `removals`. Returns the bounds of the features that changed, at
+    // their old and their new position.
+    GeoJSONChangedBounds update(FeatureCollection upserts, const std::vector<FeatureIdentifier>& removals);
+
+    const FeatureCollection& get() const {
+        return features;
+    }
+
+private:
+    void erase(std::vector<std::size_t> positions, GeoJSONChangedBounds&);
+
+    FeatureCollection features;
+    std::multimap<FeatureIdentifier, std::size_t> indices;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -1,10 +1,12 @@
-#include <mbgl/util/logging.hpp>
+#include <mbgl/actor/mailbox.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
 
 #include <mapbox/geojson.hpp>
 #include <mapbox/geojson/rapidjson.hpp>
@@ -12,9 +14,7 @@
 #include <mapbox/geojsonvt/convert.hpp>
 #include <supercluster.hpp>
 
-#include <rapidjson/error/en.h>
-
-#include <sstream>
+#include <cmath>
 
 namespace mbgl {
 namespace style {
@@ -39,6 +39,13 @@ GeoJSONSource::Impl::~Impl() = default;
 void GeoJSONSource::Impl::setURL(std::string url_) {
     url = std::move(url_);
 
+    // Discard the result of any data that is still being indexed, and updates of data that
+    // the new data replaces. Later updates wait for the new data.
+    ++correlationID;
+    indexing = false;
+    pendingUpdates.clear();
+    waitingForData = true;
+
     // Signal that the source description needs a reload
     if (loaded || req) {
         loaded = false;
@@ -54,46 +61,123 @@ optional<std::string> GeoJSONSource::Impl::getURL() const {
 
 void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
     req.reset();
-    _setGeoJSON(geoJSON);
+    waitingForData = false;
+    pendingUpdates.clear();
+
+    if (worker) {
+        index(geoJSON);
+    } else {
+        // Not attached to a style yet; indexed once the description is loaded.
+        pendingGeoJSON = geoJSON;
+    }
+}
+
+void GeoJSONSource::Impl::updateFeatures(FeatureCollection upserts, std::vector<FeatureIdentifier> removals) {
+    if (worker && !waitingForData) {
+        indexing = true;
+        worker->invoke(&GeoJSONSourceWorker::update, std::move(upserts), std::move(removals), ++correlationID);
+    } else {
+        // Applied to the data once it is there.
+        pendingUpdates.emplace_back(std::move(upserts), std::move(removals));
+    }
+}
+
+void GeoJSONSource::Impl::sendPendingUpdates() {
+    auto updates = std::move(pendingUpdates);
+    pendingUpdates.clear();
+
+    for (auto& update : updates) {
+        updateFeatures(std::move(update.first), std::move(update.second));
+    }
 }
 
 // Private implementation
-void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
-    double scale = util::EXTENT / util::tileSize;
-
-    cache.clear();
-
-    if (options.cluster
-        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
-        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options.clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = std::round(scale * options.clusterRadius);
-
-        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
-        geoJSONOrSupercluster =
-            std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+void GeoJSONSource::Impl::index(GeoJSON geoJSON) {
+    indexing = true;
+    worker->invoke(&GeoJSONSourceWorker::index, std::move(geoJSON), ++correlationID);
+}
+
+// Whether any of `bounds` touches the tile, including its buffer.
+static bool intersects(const GeoJSONChangedBounds& bounds, const CanonicalTileID& tileID, uint16_t buffer) {
+    const double scale = std::pow(2.0, tileID.z);
+    const double padding = double(buffer) / util::tileSize;
+    const double minX = (tileID.x - padding) / scale;
+    const double minY = (tileID.y - padding) / scale;
+    const double maxX = (tileID.x + 1 + padding) / scale;
+    const double maxY = (tileID.y + 1 + padding) / scale;
+
+    for (const auto& box : bounds) {
+        if (box.min.x <= maxX && box.max.x >= minX && box.min.y <= maxY && box.max.y >= minY) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeoJSONSource::Impl::onIndexed(GeoJSONIndex result,
+                                    optional<GeoJSONChangedBounds> resultChangedBounds,
+                                    uint64_t resultCorrelationID) {
+    // Superseded results are dropped, but the tiles they touched still need to be updated
+    // from the final index.
+    if (resultChangedBounds) {
+        changedBounds.insert(changedBounds.end(), resultChangedBounds->begin(), resultChangedBounds->end());
     } else {
-        mapbox::geojsonvt::Options vtOptions;
-        vtOptions.maxZoom = options.maxzoom;
-        vtOptions.extent = util::EXTENT;
-        vtOptions.buffer = std::round(scale * options.buffer);
-        vtOptions.tolerance = scale * options.tolerance;
-        geoJSONOrSupercluster = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+        allTilesChanged = true;
+    }
+
+    if (resultCorrelationID != correlationID) {
+        return; // Superseded by more recent data.
     }
 
+    indexing = false;
+    geoJSONOrSupercluster = std::move(result);
+
+    // Tiles that didn't change keep the data they were sliced from the previous index, and
+    // so do cached tiles.
+    const auto changed = [&] (const OverscaledTileID& tileID) {
+        return allTilesChanged || intersects(changedBounds, tileID.canonical, options.buffer);
+    };
+
+    cache.remove(changed);
+
     for (auto const &item : tiles) {
         GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
-        setTileData(*geoJSONTile, geoJSONTile->id);
+        if (changed(geoJSONTile->id)) {
+            setTileData(*geoJSONTile, geoJSONTile->id);
+        }
+    }
+
+    changedBounds.clear();
+    allTilesChanged = false;
+
+    // Observers are told about the first load only; later data is a change of a loaded source.
+    if (loaded) {
+        observer->onSourceChanged(base);
+    } else {
+        loaded = true;
+        observer->onSourceLoaded(base);
     }
 }
 
+void GeoJSONSource::Impl::onError(std::exception_ptr error, uint64_t resultCorrelationID) {
+    if (resultCorrelationID != correlationID) {
+        return;
+    }
+
+    indexing = false;
+    observer->onSourceError(base, error);
+}
+
 void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID& tileID) {
     if (geoJSONOrSupercluster.is<GeoJSONVTPointer>()) {
-        tile.updateData(geoJSONOrSupercluster.get<GeoJSONVTPointer>()->getTile(tileID.canonical.z,
-                                                                               tileID.canonical.x,
-                                                                               tileID.canonical.y).features);
+        const auto& geoJSONVT = geoJSONOrSupercluster.get<GeoJSONVTPointer>();
+        if (!geoJSONVT) {
+            tile.updateData({}); // The source has no data.
+            return;
+        }
+        tile.updateData(geoJSONVT->getTile(tileID.canonical.z,
+                                           tileID.canonical.x,
+                                           tileID.canonical.y).features);
     } else {
         assert(geoJSONOrSupercluster.is<SuperclusterPointer>());
         tile.updateData(geoJSONOrSupercluster.get<SuperclusterPointer>()->getTile(tileID.canonical.z,
@@ -102,9 +186,25 @@ void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID&
     }
 }
 
-void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
+void GeoJSONSource::Impl::loadDescription(FileSource& fileSource, Scheduler& scheduler) {
+    if (!worker) {
+        mailbox = std::make_shared<Mailbox>(*util::RunLoop::Get());
+        worker = std::make_unique<Actor<GeoJSONSourceWorker>>(
+            scheduler, ActorRef<Impl>(*this, mailbox), options);
+    }
+
+    if (pendingGeoJSON) {
+        index(std::move(*pendingGeoJSON));
+        pendingGeoJSON = {};
+    }
+
     if (!url) {
-        loaded = true;
+        sendPendingUpdates();
+
+        // Otherwise, the source is loaded once the worker has indexed the data.
+        if (!indexing) {
+            loaded = true;
+        }
         return;
     }
 
@@ -122,37 +222,21 @@ void GeoJSONSource::Impl::loadDescription(FileSource& fileSource) {
             observer->onSourceError(
                 base, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> d;
-            d.Parse<0>(res.data->c_str());
-
-            if (d.HasParseError()) {
-                std::stringstream message;
-                message << d.GetErrorOffset() << " - "
-                        << rapidjson::GetParseError_En(d.GetParseError());
-                observer->onSourceError(base,
-                                        std::make_exception_ptr(std::runtime_error(message.str())));
-                return;
-            }
-
-            invalidateTiles();
-
-            conversion::Result<GeoJSON> geoJSON = conversion::convertGeoJSON<JSValue>(d);
-            if (!geoJSON) {
-                Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
-                           geoJSON.error().message.c_str());
-                // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
-                // tiles to load.
-                _setGeoJSON(GeoJSON{ FeatureCollection{} });
-            } else {
-                _setGeoJSON(*geoJSON);
-            }
+            // Tiles keep showing the previous data until the worker has parsed and indexed
+            // the response.
+            indexing = true;
+            worker->invoke(&GeoJSONSourceWorker::parse, res.data, ++correlationID);
 
-            loaded = true;
-            observer->onSourceLoaded(base);
+            waitingForData = false;
+            sendPendingUpdates();
         }
     });
 }
 
+bool GeoJSONSource::Impl::isLoaded() const {
+    return !indexing && Source::Impl::isLoaded();
+}
+
 Range<uint8_t> GeoJSONSource::Impl::getZoomRange() {
     assert(loaded);
     return { 0, options.maxzoom };
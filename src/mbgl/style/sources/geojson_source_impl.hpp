@@ -2,12 +2,15 @@
 
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/variant.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 
 namespace mbgl {
 
 class AsyncRequest;
+class Mailbox;
 
 namespace style {
 
@@ -20,16 +23,26 @@ public:
     optional<std::string> getURL() const;
 
     void setGeoJSON(const GeoJSON&);
+    void updateFeatures(FeatureCollection upserts, std::vector<FeatureIdentifier> removals);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
-    void loadDescription(FileSource&) final;
+    void loadDescription(FileSource&, Scheduler&) final;
+
+    // Not loaded while newer data is being indexed, so that still images include it.
+    bool isLoaded() const final;
+
+    // Called by the worker once it has finished indexing data sent with `correlationID`.
+    // `changedBounds` is empty if all tiles need to be updated.
+    void onIndexed(GeoJSONIndex, optional<GeoJSONChangedBounds> changedBounds, uint64_t correlationID);
+    void onError(std::exception_ptr, uint64_t correlationID);
 
     uint16_t getTileSize() const final {
         return util::tileSize;
     }
 
 private:
-    void _setGeoJSON(const GeoJSON&);
+    void index(GeoJSON);
+    void sendPendingUpdates();
 
     Range<uint8_t> getZoomRange() final;
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
@@ -37,7 +50,25 @@ private:
     GeoJSONOptions options;
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
-    variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
+
+    // Data set before the source was loaded, waiting for a worker to index it, and updates
+    // waiting for the worker or for the data of the source's URL to arrive.
+    optional<GeoJSON> pendingGeoJSON;
+    std::vector<std::pair<FeatureCollection, std::vector<FeatureIdentifier>>> pendingUpdates;
+    bool waitingForData = false;
+
+    // Parsing and indexing happens on the worker. Tiles keep using the current index until
+    // the worker replies with the index of the most recent data.
+    std::shared_ptr<Mailbox> mailbox;
+    std::unique_ptr<Actor<GeoJSONSourceWorker>> worker;
+    uint64_t correlationID = 0;
+    bool indexing = false;
+
+    // Changes made by results that were superseded before they could be swapped in.
+    GeoJSONChangedBounds changedBounds;
+    bool allTilesChanged = false;
+
+    GeoJSONIndex geoJSONOrSupercluster;
 };
 
 } // namespace style
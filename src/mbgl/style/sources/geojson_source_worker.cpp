@@ -0,0 +1,89 @@
+#include <mbgl/style/sources/geojson_source_worker.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/conversion/geojson_reader.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <mapbox/geojsonvt.hpp>
+#include <supercluster.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+namespace style {
+
+GeoJSONSourceWorker::GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>,
+                                         ActorRef<GeoJSONSource::Impl> parent_,
+                                         const GeoJSONOptions options_)
+    : parent(std::move(parent_)),
+      options(options_) {
+}
+
+void GeoJSONSourceWorker::parse(std::shared_ptr<const std::string> data, uint64_t correlationID) {
+    try {
+        // Builds the features straight from the response text, without a JSON document.
+        conversion::Result<GeoJSON> geoJSON = conversion::parseGeoJSON(*data);
+
+        // Don't hold on to the response while indexing.
+        data.reset();
+
+        if (!geoJSON) {
+            Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
+                       geoJSON.error().message.c_str());
+            // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
+            // tiles to load.
+            index(GeoJSON{ FeatureCollection{} }, correlationID);
+        } else {
+            index(std::move(*geoJSON), correlationID);
+        }
+    } catch (...) {
+        parent.invoke(&GeoJSONSource::Impl::onError, std::current_exception(), correlationID);
+    }
+}
+
+void GeoJSONSourceWorker::index(GeoJSON geoJSON, uint64_t correlationID) {
+    features.reset(std::move(geoJSON));
+    reindex({}, correlationID);
+}
+
+void GeoJSONSourceWorker::update(FeatureCollection upserts,
+                                 std::vector<FeatureIdentifier> removals,
+                                 uint64_t correlationID) {
+    GeoJSONChangedBounds changed = features.update(std::move(upserts), removals);
+
+    if (options.cluster) {
+        // A changed point can move a cluster anywhere within the cluster radius, at every
+        // zoom level, so all tiles are refreshed.
+        reindex({}, correlationID);
+    } else {
+        reindex(std::move(changed), correlationID);
+    }
+}
+
+void GeoJSONSourceWorker::reindex(optional<GeoJSONChangedBounds> changed, uint64_t correlationID) {
+    double scale = util::EXTENT / util::tileSize;
+
+    GeoJSONIndex result;
+
+    if (options.cluster && !features.get().empty()) {
+        mapbox::supercluster::Options clusterOptions;
+        clusterOptions.maxZoom = options.clusterMaxZoom;
+        clusterOptions.extent = util::EXTENT;
+        clusterOptions.radius = std::round(scale * options.clusterRadius);
+
+        result = std::make_unique<mapbox::supercluster::Supercluster>(features.get(), clusterOptions);
+    } else {
+        mapbox::geojsonvt::Options vtOptions;
+        vtOptions.maxZoom = options.maxzoom;
+        vtOptions.extent = util::EXTENT;
+        vtOptions.buffer = std::round(scale * options.buffer);
+        vtOptions.tolerance = scale * options.tolerance;
+        // Takes the features by reference; only the projected tiles are kept.
+        result = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features.get(), vtOptions);
+    }
+
+    parent.invoke(&GeoJSONSource::Impl::onIndexed, std::move(result), std::move(changed), correlationID);
+}
+
+} // namespace style
+} // namespace mbgl
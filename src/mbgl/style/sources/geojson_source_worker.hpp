@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_features.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/variant.hpp>
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+using GeoJSONIndex = variant<GeoJSONVTPointer, SuperclusterPointer>;
+
+// Parses GeoJSON and builds the geojson-vt or supercluster index of a GeoJSONSource on a
+// worker thread. Each finished index is sent back to the source, which swaps it in. The
+// worker keeps the source's features so that individual features can be updated without
+// sending the complete data again.
+class GeoJSONSourceWorker {
+public:
+    GeoJSONSourceWorker(ActorRef<GeoJSONSourceWorker>,
+                        ActorRef<GeoJSONSource::Impl> parent,
+                        const GeoJSONOptions);
+
+    void parse(std::shared_ptr<const std::string> data, uint64_t correlationID);
+    void index(GeoJSON, uint64_t correlationID);
+
+    // Adds or replaces the features in `upserts`, matched by identifier, and removes the
+    // features identified by `removals`.
+    void update(FeatureCollection upserts, std::vector<FeatureIdentifier> removals, uint64_t correlationID);
+
+private:
+    void reindex(optional<GeoJSONChangedBounds>, uint64_t correlationID);
+
+    ActorRef<GeoJSONSource::Impl> parent;
+    const GeoJSONOptions options;
+
+    GeoJSONFeatures features;
+};
+
+} // namespace style
+} // namespace mbgl
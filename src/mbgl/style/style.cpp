@@ -22,6 +22,7 @@
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
+#include <mbgl/tile/layout_cache.hpp>
 #include <mbgl/renderer/render_item.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/util/constants.hpp>
@@ -39,11 +40,13 @@ namespace style {
 
 static Observer nullObserver;
 
-Style::Style(FileSource& fileSource_, float pixelRatio)
-    : fileSource(fileSource_),
+Style::Style(Scheduler& scheduler_, FileSource& fileSource_, float pixelRatio)
+    : scheduler(scheduler_),
+      fileSource(fileSource_),
       glyphAtlas(std::make_unique<GlyphAtlas>(Size{ 2048, 2048 }, fileSource)),
       spriteAtlas(std::make_unique<SpriteAtlas>(Size{ 1024, 1024 }, pixelRatio)),
       lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 })),
+      layoutCache(std::make_unique<LayoutCache>()),
       observer(&nullObserver) {
     glyphAtlas->setObserver(this);
     spriteAtlas->setObserver(this);
@@ -342,7 +345,7 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
         if (Source* source = getSource(layer->baseImpl->source)) {
             source->baseImpl->enabled = true;
             if (!source->baseImpl->loaded) {
-                source->baseImpl->loadDescription(fileSource);
+                source->baseImpl->loadDescription(fileSource, scheduler);
             }
         }
     }
@@ -591,6 +594,10 @@ void Style::onSourceLoaded(Source& source) {
     observer->onUpdate(Update::Repaint);
 }
 
+void Style::onSourceChanged(Source&) {
+    observer->onUpdate(Update::Repaint);
+}
+
 void Style::onSourceAttributionChanged(Source& source, const std::string& attribution) {
     observer->onSourceAttributionChanged(source, attribution);
 }
@@ -606,7 +613,7 @@ void Style::onSourceError(Source& source, std::exception_ptr error) {
 void Style::onSourceDescriptionChanged(Source& source) {
     observer->onSourceDescriptionChanged(source);
     if (!source.baseImpl->loaded) {
-        source.baseImpl->loadDescription(fileSource);
+        source.baseImpl->loadDescription(fileSource, scheduler);
     }
 }
 
@@ -16,6 +16,7 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geo.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -24,9 +25,11 @@
 namespace mbgl {
 
 class FileSource;
+class Scheduler;
 class GlyphAtlas;
 class SpriteAtlas;
 class LineAtlas;
+class LayoutCache;
 class RenderData;
 class TransformState;
 class RenderedQueryOptions;
@@ -43,7 +46,7 @@ class Style : public GlyphAtlasObserver,
               public LayerObserver,
               public util::noncopyable {
 public:
-    Style(FileSource&, float pixelRatio);
+    Style(Scheduler&, FileSource&, float pixelRatio);
     ~Style() override;
 
     void setJSON(const std::string&);
@@ -108,10 +111,15 @@ public:
 
     void dumpDebugLogs() const;
 
+    Scheduler& scheduler;
     FileSource& fileSource;
     std::unique_ptr<GlyphAtlas> glyphAtlas;
     std::unique_ptr<SpriteAtlas> spriteAtlas;
     std::unique_ptr<LineAtlas> lineAtlas;
+    std::unique_ptr<LayoutCache> layoutCache;
+
+    // Whether tile workers spread the layout of a tile over the worker scheduler.
+    std::atomic<bool> parallelLayout { false };
 
 private:
     std::vector<std::unique_ptr<Source>> sources;
@@ -140,6 +148,7 @@ private:
 
     // SourceObserver implementation.
     void onSourceLoaded(Source&) override;
+    void onSourceChanged(Source&) override;
     void onSourceAttributionChanged(Source&, const std::string&) override;
     void onSourceError(Source&, std::exception_ptr) override;
     void onSourceDescriptionChanged(Source&) override;
@@ -10,9 +10,72 @@
 #include <mapbox/geometry/multi_point.hpp>
 
 #include <cmath>
+#include <limits>
+#include <unordered_set>
 
 namespace mbgl {
 
+namespace {
+
+// The grid covers the rotated tile, including its buffer, in 64 x 64 cells.
+constexpr int32_t gridSize = 64;
+constexpr float gridMin = -1.5f * util::EXTENT;
+constexpr float gridCellSize = 3.0f * util::EXTENT / gridSize;
+constexpr uint32_t gridNone = std::numeric_limits<uint32_t>::max();
+
+int32_t gridCoord(float value) {
+    const float cell = std::floor((value - gridMin) / gridCellSize);
+    // Written to also map NaN to the first cell.
+    if (!(cell > 0)) {
+        return 0;
+    }
+    return cell < gridSize - 1 ? int32_t(cell) : gridSize - 1;
+}
+
+} // namespace
+
+void CollisionTile::Grid::insert(uint32_t box, const TreeBox& bounds) {
+    if (cells.empty()) {
+        cells.resize(gridSize * gridSize, gridNone);
+    }
+
+    const int32_t cx1 = gridCoord(bounds.x1);
+    const int32_t cy1 = gridCoord(bounds.y1);
+    const int32_t cx2 = gridCoord(bounds.x2);
+    const int32_t cy2 = gridCoord(bounds.y2);
+
+    for (int32_t y = cy1; y <= cy2; ++y) {
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            uint32_t& head = cells[y * gridSize + x];
+            entryBoxes.push_back(box);
+            entryNext.push_back(head);
+            head = uint32_t(entryBoxes.size() - 1);
+        }
+    }
+}
+
+template <class Fn>
+void CollisionTile::Grid::query(const TreeBox& bounds, Fn&& fn) const {
+    if (cells.empty()) {
+        return;
+    }
+
+    const int32_t cx1 = gridCoord(bounds.x1);
+    const int32_t cy1 = gridCoord(bounds.y1);
+    const int32_t cx2 = gridCoord(bounds.x2);
+    const int32_t cy2 = gridCoord(bounds.y2);
+
+    for (int32_t y = cy1; y <= cy2; ++y) {
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            for (uint32_t entry = cells[y * gridSize + x]; entry != gridNone; entry = entryNext[entry]) {
+                if (!fn(entryBoxes[entry])) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
 CollisionTile::CollisionTile(PlacementConfig config_) : config(std::move(config_)) {
     // Compute the transformation matrix.
     const float angle_sin = std::sin(config.angle);
@@ -87,13 +150,16 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
         const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
-                const CollisionBox& blocking = std::get<1>(*it);
-                Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
-
-                minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
-                if (minPlacementScale >= maxScale) return minPlacementScale;
-            }
+            const TreeBox bounds = getTreeBox(anchor, box);
+            grid.query(bounds, [&] (uint32_t i) {
+                const TreeBox& other = boxBounds[i];
+                if (bounds.x1 <= other.x2 && bounds.x2 >= other.x1 &&
+                    bounds.y1 <= other.y2 && bounds.y2 >= other.y1) {
+                    minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, boxAnchors[i], boxes[i]));
+                }
+                return minPlacementScale < maxScale;
+            });
+            if (minPlacementScale >= maxScale) return minPlacementScale;
         }
 
         if (avoidEdges) {
@@ -124,14 +190,20 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
     }
 
     if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
+        const auto featureIndex = uint32_t(features.size());
+        features.push_back(feature.indexedFeature);
+
         for (auto& box : feature.boxes) {
-            treeBoxes.emplace_back(getTreeBox(util::matrixMultiply(rotationMatrix, box.anchor), box), box, feature.indexedFeature);
-        }
-        if (ignorePlacement) {
-            ignoredTree.insert(treeBoxes.begin(), treeBoxes.end());
-        } else {
-            tree.insert(treeBoxes.begin(), treeBoxes.end());
+            const auto index = uint32_t(boxes.size());
+            const Point<float> anchor = util::matrixMultiply(rotationMatrix, box.anchor);
+            const TreeBox bounds = getTreeBox(anchor, box);
+
+            boxBounds.push_back(bounds);
+            boxAnchors.push_back(anchor);
+            boxes.push_back(box);
+            boxFeatures.push_back(featureIndex);
+
+            (ignorePlacement ? ignoredGrid : grid).insert(index, bounds);
         }
     }
 
@@ -154,23 +226,19 @@ void CollisionTile::insertFeature(CollisionFeature& feature, float minPlacementS
 // |             |             | calculating the bounds at current zoom level
 // |             |      (x2,y2)| we must unscale the box using its center as
 // +---------------------------+ transform origin.
-Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
+CollisionTile::TreeBox CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale) {
     assert(box.x1 <= box.x2 && box.y1 <= box.y2);
-    return Box{
-        CollisionPoint{
-            anchor.x + box.x1 / scale,
-            anchor.y + box.y1 / scale * yStretch
-        },
-        CollisionPoint{
-            anchor.x + box.x2 / scale,
-            anchor.y + box.y2 / scale * yStretch
-        }
+    return TreeBox {
+        anchor.x + box.x1 / scale,
+        anchor.y + box.y1 / scale * yStretch,
+        anchor.x + box.x2 / scale,
+        anchor.y + box.y2 / scale * yStretch
     };
 }
 
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
-    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
+    if (queryGeometry.empty() || boxes.empty()) {
         return result;
     }
 
@@ -182,27 +250,29 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         polygon.push_back(convertPoint<int16_t>(rotated));
     }
 
-    // Predicate for ruling out already seen features.
-    std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
-    auto seenFeature = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const IndexedSubfeature& feature = std::get<2>(treeBox);
-        const auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
-        return seenFeatures.find(feature.index) == seenFeatures.end();
-    };
+    // Used for ruling out already seen features, keyed by source layer and feature index.
+    std::unordered_set<uint64_t> seenFeatures;
 
     // Account for the rounding done when updating symbol shader variables.
     const float roundedScale = std::pow(2.0f, std::ceil(util::log2(scale) * 10.0f) / 10.0f);
 
-    // Check if feature is rendered (collision free) at current scale.
-    auto visibleAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& box = std::get<1>(treeBox);
-        return roundedScale >= box.placementScale && roundedScale <= box.maxScale;
-    };
+    // Boxes are stored at scale 1, so their bounds at the query scale can't be looked up in the
+    // grid; instead, scan all of them, starting with the cheapest tests.
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        // Check if feature is rendered (collision free) at current scale.
+        const CollisionBox& collisionBox = boxes[i];
+        if (roundedScale < collisionBox.placementScale || roundedScale > collisionBox.maxScale) {
+            continue;
+        }
 
-    // Check if query polygon intersects with the feature box at current scale.
-    auto intersectsAtScale = [&] (const CollisionTreeBox& treeBox) -> bool {
-        const CollisionBox& collisionBox = std::get<1>(treeBox);
-        const auto anchor = util::matrixMultiply(rotationMatrix, collisionBox.anchor);
+        const IndexedSubfeature& feature = features[boxFeatures[i]];
+        const uint64_t featureKey = (uint64_t(feature.sourceLayerName) << 32) | feature.index;
+        if (seenFeatures.find(featureKey) != seenFeatures.end()) {
+            continue;
+        }
+
+        // Check if query polygon intersects with the feature box at current scale.
+        const auto& anchor = boxAnchors[i];
         const int16_t x1 = anchor.x + collisionBox.x1 / scale;
         const int16_t y1 = anchor.y + collisionBox.y1 / scale * yStretch;
         const int16_t x2 = anchor.x + collisionBox.x2 / scale;
@@ -210,24 +280,13 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         auto bbox = GeometryCoordinates {
             { x1, y1 }, { x2, y1 }, { x2, y2 }, { x1, y2 }
         };
-        return util::polygonIntersectsPolygon(polygon, bbox);
-    };
-
-    auto predicates = bgi::satisfies(seenFeature)
-                   && bgi::satisfies(visibleAtScale)
-                   && bgi::satisfies(intersectsAtScale);
-
-    auto queryTree = [&](const auto& tree_) {
-        for (auto it = tree_.qbegin(predicates); it != tree_.qend(); ++it) {
-            const IndexedSubfeature& feature = std::get<2>(*it);
-            auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
-            seenFeatures.insert(feature.index);
-            result.push_back(feature);
+        if (!util::polygonIntersectsPolygon(polygon, bbox)) {
+            continue;
         }
-    };
 
-    queryTree(tree);
-    queryTree(ignoredTree);
+        seenFeatures.insert(featureKey);
+        result.push_back(feature);
+    }
 
     return result;
 }
@@ -4,37 +4,12 @@
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wunused-variable"
-#pragma GCC diagnostic ignored "-Wshadow"
-#ifdef __clang__
-#pragma GCC diagnostic ignored "-Wunknown-pragmas"
-#endif
-#pragma GCC diagnostic ignored "-Wpragmas"
-#pragma GCC diagnostic ignored "-Wdeprecated-register"
-#pragma GCC diagnostic ignored "-Wshorten-64-to-32"
-#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#pragma GCC diagnostic pop
+#include <array>
+#include <cstdint>
+#include <vector>
 
 namespace mbgl {
 
-namespace bg = boost::geometry;
-namespace bgm = bg::model;
-namespace bgi = bg::index;
-typedef bgm::point<float, 2, bg::cs::cartesian> CollisionPoint;
-typedef bgm::box<CollisionPoint> Box;
-typedef std::tuple<Box, CollisionBox, IndexedSubfeature> CollisionTreeBox;
-typedef bgi::rtree<CollisionTreeBox, bgi::linear<16, 4>> Tree;
-
-class IndexedSubfeature;
-
 class CollisionTile {
 public:
     explicit CollisionTile(PlacementConfig);
@@ -54,13 +29,50 @@ public:
     std::array<float, 4> reverseRotationMatrix;
 
 private:
+    // The bounds of a collision box in the rotated and y-stretched space in which boxes
+    // are compared with each other.
+    struct TreeBox {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+    };
+
     float findPlacementScale(
             const Point<float>& anchor, const CollisionBox& box,
             const Point<float>& blockingAnchor, const CollisionBox& blocking);
-    Box getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale = 1.0);
+    TreeBox getTreeBox(const Point<float>& anchor, const CollisionBox& box, const float scale = 1.0);
+
+    // A uniform grid over the rotated tile space. Each cell holds a singly linked list of
+    // box indices, stored in two flat arrays, so that inserting a box never allocates per
+    // cell. Boxes outside the grid bounds are clamped into the border cells.
+    class Grid {
+    public:
+        void insert(uint32_t box, const TreeBox&);
+
+        // Calls `fn(box)` for every box sharing a cell with the given bounds, until `fn`
+        // returns false. A box that spans multiple cells may be visited more than once.
+        template <class Fn>
+        void query(const TreeBox&, Fn&&) const;
+
+    private:
+        std::vector<uint32_t> cells;
+        std::vector<uint32_t> entryBoxes;
+        std::vector<uint32_t> entryNext;
+    };
+
+    // All inserted boxes as a structure of arrays indexed by box: bounds are scanned
+    // for every collision test, the remaining data is only read on a hit.
+    std::vector<TreeBox> boxBounds;
+    std::vector<Point<float>> boxAnchors; // rotated
+    std::vector<CollisionBox> boxes;
+    std::vector<uint32_t> boxFeatures;
+
+    // The features the boxes belong to; shared by all boxes of a feature.
+    std::vector<IndexedSubfeature> features;
 
-    Tree tree;
-    Tree ignoredTree;
+    Grid grid;
+    Grid ignoredGrid;
 };
 
 } // namespace mbgl
@@ -64,9 +64,24 @@ bool GlyphAtlas::hasGlyphRanges(const FontStack& fontStack, const GlyphRangeSet&
     return hasRanges;
 }
 
-util::exclusive<GlyphSet> GlyphAtlas::getGlyphSet(const FontStack& fontStack) {
-    auto lock = std::make_unique<std::lock_guard<std::mutex>>(mutex);
-    return { &entries[fontStack].glyphSet, std::move(lock) };
+std::shared_ptr<const GlyphSet> GlyphAtlas::getGlyphSet(const FontStack& fontStack) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& glyphSet = entries[fontStack].glyphSet;
+    if (!glyphSet) {
+        glyphSet = std::make_shared<const GlyphSet>();
+    }
+    return glyphSet;
+}
+
+void GlyphAtlas::addGlyphSet(const FontStack& fontStack, const GlyphSet& glyphs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& glyphSet = entries[fontStack].glyphSet;
+
+    // Glyph sets that have been handed out stay as they are; copying one only copies
+    // references to its glyphs.
+    auto updated = glyphSet ? std::make_shared<GlyphSet>(*glyphSet) : std::make_shared<GlyphSet>();
+    updated->insert(glyphs);
+    glyphSet = std::move(updated);
 }
 
 void GlyphAtlas::setObserver(GlyphAtlasObserver* observer_) {
@@ -76,10 +91,13 @@ void GlyphAtlas::setObserver(GlyphAtlasObserver* observer_) {
 void GlyphAtlas::addGlyphs(uintptr_t tileUID,
                            const std::u16string& text,
                            const FontStack& fontStack,
-                           const util::exclusive<GlyphSet>& glyphSet,
+                           const GlyphSet& glyphSet,
                            GlyphPositions& face)
 {
-    const std::map<uint32_t, SDFGlyph>& sdfs = glyphSet->getSDFs();
+    const SDFGlyphs& sdfs = glyphSet.getSDFs();
+
+    std::lock_guard<std::mutex> lock(atlasMutex);
+    std::map<uint32_t, GlyphValue>& values = glyphValues[fontStack];
 
     for (char16_t chr : text)
     {
@@ -88,17 +106,16 @@ void GlyphAtlas::addGlyphs(uintptr_t tileUID,
             continue;
         }
 
-        const SDFGlyph& sdf = sdf_it->second;
-        Rect<uint16_t> rect = addGlyph(tileUID, fontStack, sdf);
+        const SDFGlyph& sdf = *sdf_it->second;
+        Rect<uint16_t> rect = addGlyph(tileUID, values, sdf);
         face.emplace(chr, Glyph{rect, sdf.metrics});
     }
 }
 
 Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
-                                    const FontStack& fontStack,
+                                    std::map<uint32_t, GlyphValue>& face,
                                     const SDFGlyph& glyph)
 {
-    std::map<uint32_t, GlyphValue>& face = entries[fontStack].glyphValues;
     auto it = face.find(glyph.id);
 
     // The glyph is already in this texture.
@@ -142,10 +159,10 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
 }
 
 void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(atlasMutex);
 
-    for (auto& entry : entries) {
-        std::map<uint32_t, GlyphValue>& face = entry.second.glyphValues;
+    for (auto& entry : glyphValues) {
+        std::map<uint32_t, GlyphValue>& face = entry.second;
         for (auto it = face.begin(); it != face.end(); /* we advance in the body */) {
             GlyphValue& value = it->second;
             value.ids.erase(tileUID);
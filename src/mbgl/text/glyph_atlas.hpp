@@ -6,7 +6,6 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/font_stack.hpp>
-#include <mbgl/util/exclusive.hpp>
 #include <mbgl/util/work_queue.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/gl/texture.hpp>
@@ -33,7 +32,13 @@ public:
     GlyphAtlas(Size, FileSource&);
     ~GlyphAtlas();
 
-    util::exclusive<GlyphSet> getGlyphSet(const FontStack&);
+    // Returns the glyphs of the font stack that have been loaded so far. The glyph set is never
+    // modified once it has been returned, so it can be used without holding a lock. This method
+    // can be called from any thread.
+    std::shared_ptr<const GlyphSet> getGlyphSet(const FontStack&);
+
+    // Publishes a new glyph set for the font stack that includes the given glyphs.
+    void addGlyphSet(const FontStack&, const GlyphSet&);
 
     // Returns true if the set of GlyphRanges are available and parsed or false
     // if they are not. For the missing ranges, a request on the FileSource is
@@ -52,10 +57,12 @@ public:
 
     void setObserver(GlyphAtlasObserver* observer);
 
+    // Allocates space in the atlas for the glyphs of the text. Only this, and removing glyphs,
+    // is serialized between threads.
     void addGlyphs(uintptr_t tileUID,
                    const std::u16string& text,
                    const FontStack&,
-                   const util::exclusive<GlyphSet>&,
+                   const GlyphSet&,
                    GlyphPositions&);
     void removeGlyphs(uintptr_t tileUID);
 
@@ -71,13 +78,6 @@ public:
 private:
     void requestGlyphRange(const FontStack&, const GlyphRange&);
 
-    Rect<uint16_t> addGlyph(uintptr_t tileID,
-                            const FontStack&,
-                            const SDFGlyph&);
-
-    FileSource& fileSource;
-    std::string glyphURL;
-
     struct GlyphValue {
         GlyphValue(Rect<uint16_t> rect_, uintptr_t id)
             : rect(std::move(rect_)), ids({ id }) {}
@@ -85,15 +85,26 @@ private:
         std::unordered_set<uintptr_t> ids;
     };
 
+    Rect<uint16_t> addGlyph(uintptr_t tileID,
+                            std::map<uint32_t, GlyphValue>&,
+                            const SDFGlyph&);
+
+    FileSource& fileSource;
+    std::string glyphURL;
+
     struct Entry {
         std::map<GlyphRange, GlyphPBF> ranges;
-        GlyphSet glyphSet;
-        std::map<uint32_t, GlyphValue> glyphValues;
+        std::shared_ptr<const GlyphSet> glyphSet;
     };
 
+    // Guarded by `mutex`.
     std::unordered_map<FontStack, Entry, FontStackHash> entries;
     std::mutex mutex;
 
+    // Guarded by `atlasMutex`, along with `bin` and `image`.
+    std::unordered_map<FontStack, std::map<uint32_t, GlyphValue>, FontStackHash> glyphValues;
+    std::mutex atlasMutex;
+
     util::WorkQueue workQueue;
     GlyphAtlasObserver* observer = nullptr;
 
@@ -117,7 +117,11 @@ GlyphPBF::GlyphPBF(GlyphAtlas* atlas,
             observer->onGlyphsLoaded(fontStack, glyphRange);
         } else {
             try {
-                parseGlyphPBF(**atlas->getGlyphSet(fontStack), glyphRange, *res.data);
+                // Parse into a separate set, so that workers can keep using the published
+                // glyphs meanwhile.
+                GlyphSet glyphSet;
+                parseGlyphPBF(glyphSet, glyphRange, *res.data);
+                atlas->addGlyphSet(fontStack, glyphSet);
             } catch (...) {
                 observer->onGlyphsError(fontStack, glyphRange, std::current_exception());
                 return;
@@ -2,6 +2,7 @@
 #include <mbgl/text/glyph_set.hpp>
 #include <mbgl/util/i18n.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
 
 #include <boost/algorithm/string.hpp>
 
@@ -11,18 +12,28 @@
 namespace mbgl {
 
 void GlyphSet::insert(uint32_t id, SDFGlyph&& glyph) {
+    insert(id, std::make_shared<const SDFGlyph>(std::move(glyph)));
+}
+
+void GlyphSet::insert(const GlyphSet& other) {
+    for (const auto& sdf : other.sdfs) {
+        insert(sdf.first, sdf.second);
+    }
+}
+
+void GlyphSet::insert(uint32_t id, std::shared_ptr<const SDFGlyph> glyph) {
     auto it = sdfs.find(id);
     if (it == sdfs.end()) {
         // Glyph doesn't exist yet.
         sdfs.emplace(id, std::move(glyph));
-    } else if (it->second.metrics == glyph.metrics) {
-        if (it->second.bitmap != glyph.bitmap) {
+    } else if (it->second->metrics == glyph->metrics) {
+        if (it->second->bitmap != glyph->bitmap) {
             // The actual bitmap was updated; this is unsupported.
             Log::Warning(Event::Glyph, "Modified glyph changed bitmap represenation");
         }
         // At least try to update it in case it's currently unsused.
         // If it is already used; we won't attempt to update the glyph atlas texture.
-        it->second.bitmap = std::move(glyph.bitmap);
+        it->second = std::move(glyph);
     } else {
         // The metrics were updated; this is unsupported.
         Log::Warning(Event::Glyph, "Modified glyph has different metrics");
@@ -30,7 +41,7 @@ void GlyphSet::insert(uint32_t id, SDFGlyph&& glyph) {
     }
 }
 
-const std::map<uint32_t, SDFGlyph>& GlyphSet::getSDFs() const {
+const SDFGlyphs& GlyphSet::getSDFs() const {
     return sdfs;
 }
 
@@ -44,12 +55,13 @@ const Shaping GlyphSet::getShaping(const std::u16string& logicalInput,
                                    const Point<float>& translate,
                                    const float verticalHeight,
                                    const WritingModeType writingMode,
-                                   BiDi& bidi) const {
+                                   BiDi& bidi,
+                                   util::MonotonicArena& arena) const {
     Shaping shaping(translate.x * 24, translate.y * 24, writingMode);
 
     std::vector<std::u16string> reorderedLines =
         bidi.processText(logicalInput,
-                         determineLineBreaks(logicalInput, spacing, maxWidth, writingMode));
+                         determineLineBreaks(logicalInput, spacing, maxWidth, writingMode, arena));
 
     shapeLines(shaping, reorderedLines, spacing, lineHeight, horizontalAlign, verticalAlign,
                justify, translate, verticalHeight, writingMode);
@@ -78,7 +90,7 @@ void align(Shaping& shaping,
 
 // justify left = 0, right = 1, center = .5
 void justifyLine(std::vector<PositionedGlyph>& positionedGlyphs,
-                 const std::map<uint32_t, SDFGlyph>& sdfs,
+                 const SDFGlyphs& sdfs,
                  std::size_t start,
                  std::size_t end,
                  float justify) {
@@ -89,7 +101,7 @@ void justifyLine(std::vector<PositionedGlyph>& positionedGlyphs,
     PositionedGlyph& glyph = positionedGlyphs[end];
     auto it = sdfs.find(glyph.glyph);
     if (it != sdfs.end()) {
-        const uint32_t lastAdvance = it->second.metrics.advance;
+        const uint32_t lastAdvance = it->second->metrics.advance;
         const float lineIndent = float(glyph.x + lastAdvance) * justify;
 
         for (std::size_t j = start; j <= end; j++) {
@@ -106,7 +118,7 @@ float GlyphSet::determineAverageLineWidth(const std::u16string& logicalInput,
     for (char16_t chr : logicalInput) {
         auto it = sdfs.find(chr);
         if (it != sdfs.end()) {
-            totalWidth += it->second.metrics.advance + spacing;
+            totalWidth += it->second->metrics.advance + spacing;
         }
     }
 
@@ -160,8 +172,11 @@ struct PotentialBreak {
     const float badness;
 };
 
+// Breaks refer to each other, so they are kept in a list, whose nodes come from the arena of the
+// tile's layout.
+using PotentialBreaks = std::list<PotentialBreak, util::ArenaAllocator<PotentialBreak>>;
 
-PotentialBreak evaluateBreak(const std::size_t breakIndex, const float breakX, const float targetWidth, const std::list<PotentialBreak>& potentialBreaks, const float penalty, const bool isLastBreak) {
+PotentialBreak evaluateBreak(const std::size_t breakIndex, const float breakX, const float targetWidth, const PotentialBreaks& potentialBreaks, const float penalty, const bool isLastBreak) {
     // We could skip evaluating breaks where the line length (breakX - priorBreak.x) > maxWidth
     //  ...but in fact we allow lines longer than maxWidth (if there's no break points)
     //  ...and when targetWidth and maxWidth are close, strictly enforcing maxWidth can give
@@ -198,7 +213,8 @@ std::set<std::size_t> leastBadBreaks(const PotentialBreak& lastLineBreak) {
 std::set<std::size_t> GlyphSet::determineLineBreaks(const std::u16string& logicalInput,
                                                 const float spacing,
                                                 float maxWidth,
-                                                const WritingModeType writingMode) const {
+                                                const WritingModeType writingMode,
+                                                util::MonotonicArena& arena) const {
     if (!maxWidth || writingMode != WritingModeType::Horizontal) {
         return {};
     }
@@ -209,14 +225,14 @@ std::set<std::size_t> GlyphSet::determineLineBreaks(const std::u16string& logica
 
     const float targetWidth = determineAverageLineWidth(logicalInput, spacing, maxWidth);
 
-    std::list<PotentialBreak> potentialBreaks;
+    PotentialBreaks potentialBreaks { util::ArenaAllocator<PotentialBreak>(arena) };
     float currentX = 0;
 
     for (std::size_t i = 0; i < logicalInput.size(); i++) {
         const char16_t codePoint = logicalInput[i];
         auto it = sdfs.find(codePoint);
         if (it != sdfs.end() && !boost::algorithm::is_any_of(u" \t\n\v\f\r")(codePoint)) {
-            currentX += it->second.metrics.advance + spacing;
+            currentX += it->second->metrics.advance + spacing;
         }
 
         // Ideographic characters, spaces, and word-breaking punctuation that often appear without
@@ -267,7 +283,7 @@ void GlyphSet::shapeLines(Shaping& shaping,
                 continue;
             }
 
-            const SDFGlyph& glyph = it->second;
+            const SDFGlyph& glyph = *it->second;
 
             if (writingMode == WritingModeType::Horizontal || !util::i18n::hasUprightVerticalOrientation(chr)) {
                 shaping.positionedGlyphs.emplace_back(chr, x, y, 0);
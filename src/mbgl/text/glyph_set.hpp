@@ -4,12 +4,23 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
+namespace util {
+class MonotonicArena;
+} // namespace util
+
+// Glyphs are shared between the copies of a glyph set, so that a copy with additional glyphs
+// can be published while others are still shaping text with the original.
+using SDFGlyphs = std::map<uint32_t, std::shared_ptr<const SDFGlyph>>;
+
 class GlyphSet {
 public:
     void insert(uint32_t id, SDFGlyph&&);
-    const std::map<uint32_t, SDFGlyph>& getSDFs() const;
+    void insert(const GlyphSet&);
+    const SDFGlyphs& getSDFs() const;
     const Shaping getShaping(const std::u16string& string,
                              float maxWidth,
                              float lineHeight,
@@ -20,7 +31,8 @@ public:
                              const Point<float>& translate,
                              float verticalHeight,
                              const WritingModeType,
-                             BiDi& bidi) const;
+                             BiDi& bidi,
+                             util::MonotonicArena&) const;
 
 private:
     float determineAverageLineWidth(const std::u16string& logicalInput,
@@ -29,7 +41,8 @@ private:
     std::set<std::size_t> determineLineBreaks(const std::u16string& logicalInput,
                                           const float spacing,
                                           float maxWidth,
-                                          const WritingModeType) const;
+                                          const WritingModeType,
+                                          util::MonotonicArena&) const;
 
     void shapeLines(Shaping& shaping,
                     const std::vector<std::u16string>& lines,
@@ -42,7 +55,9 @@ private:
                     float verticalHeight,
                     const WritingModeType) const;
 
-    std::map<uint32_t, SDFGlyph> sdfs;
+    void insert(uint32_t id, std::shared_ptr<const SDFGlyph>);
+
+    SDFGlyphs sdfs;
 };
 
 } // end namespace mbgl
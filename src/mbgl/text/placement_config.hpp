@@ -1,5 +1,9 @@
 #pragma once
 
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+
 namespace mbgl {
 
 class PlacementConfig {
@@ -16,10 +20,24 @@ public:
         return !operator==(rhs);
     }
 
+    // Returns true if placing symbols with `rhs` would give practically the same result as
+    // placing them with this config. Rotating or tilting the map by less than the tolerance
+    // moves nearby collision boxes by a fraction of a pixel relative to each other, which is
+    // well within the symbol padding, so an existing placement can be reused.
+    bool isCloseTo(const PlacementConfig& rhs) const {
+        const float angleDelta = std::abs(std::remainder(angle - rhs.angle, float(util::M2PI)));
+        return debug == rhs.debug &&
+               angleDelta < tolerance &&
+               std::abs(pitch - rhs.pitch) < tolerance;
+    }
+
 public:
     float angle;
     float pitch;
     bool debug;
+
+    // One degree, in radians.
+    static constexpr float tolerance = util::DEG2RAD;
 };
 
 } // namespace mbgl
@@ -48,6 +48,14 @@ public:
         }
         return optional<Value>();
     }
+
+    FeatureValue lookupValue(const std::string& key) const override {
+        auto it = feature.properties.find(key);
+        if (it != feature.properties.end()) {
+            return &it->second;
+        }
+        return FeatureValue();
+    }
 };
 
 class GeoJSONTileData : public GeometryTileData,
@@ -59,10 +67,6 @@ public:
         : features(std::move(features_)) {
     }
 
-    std::unique_ptr<GeometryTileData> clone() const override {
-        return std::make_unique<GeoJSONTileData>(*this);
-    }
-
     const GeometryTileLayer* getLayer(const std::string&) const override {
         return this;
     }
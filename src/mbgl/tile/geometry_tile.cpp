@@ -32,7 +32,11 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
              id_,
+             sourceID,
              *parameters.style.glyphAtlas,
+             *parameters.style.layoutCache,
+             parameters.workerScheduler,
+             parameters.style.parallelLayout,
              obsolete,
              parameters.mode) {
 }
@@ -49,7 +53,7 @@ void GeometryTile::setError(std::exception_ptr err) {
     observer->onTileError(*this, err);
 }
 
-void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
+void GeometryTile::setData(std::shared_ptr<const GeometryTileData> data_) {
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     if (availableData == DataAvailability::All) {
@@ -61,8 +65,16 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     redoLayout();
 }
 
-void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
-    if (requestedConfig == desiredConfig) {
+void GeometryTile::setPriority(Scheduler::Priority priority) {
+    worker.setPriority(priority);
+}
+
+void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig, bool cameraIsMoving) {
+    // Continuous rotation or tilting would otherwise redo placement for every frame. Keep the
+    // current placement until the map has moved far enough for the result to differ, or until
+    // it stops moving, so that the final placement matches the final camera.
+    if (requestedConfig && (cameraIsMoving ? requestedConfig->isCloseTo(desiredConfig)
+                                           : *requestedConfig == desiredConfig)) {
         return;
     }
 
@@ -126,6 +138,13 @@ void GeometryTile::onPlacement(PlacementResult result) {
     observer->onTileChanged(*this);
 }
 
+optional<PlacementConfig> GeometryTile::getPlacementConfig() const {
+    if (!collisionTile) {
+        return {};
+    }
+    return collisionTile->config;
+}
+
 void GeometryTile::onError(std::exception_ptr err) {
     availableData = DataAvailability::All;
     observer->onTileError(*this, err);
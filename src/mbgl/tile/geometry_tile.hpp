@@ -33,9 +33,10 @@ public:
     ~GeometryTile() override;
 
     void setError(std::exception_ptr);
-    void setData(std::unique_ptr<const GeometryTileData>);
+    void setData(std::shared_ptr<const GeometryTileData>);
 
-    void setPlacementConfig(const PlacementConfig&) override;
+    void setPriority(Scheduler::Priority) override;
+    void setPlacementConfig(const PlacementConfig&, bool cameraIsMoving) override;
     void symbolDependenciesChanged() override;
     void redoLayout() override;
 
@@ -57,7 +58,7 @@ public:
     public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
         std::unique_ptr<FeatureIndex> featureIndex;
-        std::unique_ptr<GeometryTileData> tileData;
+        std::shared_ptr<const GeometryTileData> tileData;
         uint64_t correlationID;
     };
     void onLayout(LayoutResult);
@@ -70,6 +71,9 @@ public:
     };
     void onPlacement(PlacementResult);
 
+    // The config that the symbols the tile currently shows were placed with, if any.
+    optional<PlacementConfig> getPlacementConfig() const;
+
     void onError(std::exception_ptr);
     
 protected:
@@ -92,7 +96,7 @@ private:
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
     std::unique_ptr<FeatureIndex> featureIndex;
-    std::unique_ptr<const GeometryTileData> data;
+    std::shared_ptr<const GeometryTileData> data;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
     std::unique_ptr<CollisionTile> collisionTile;
@@ -1,11 +1,45 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
 
 #include <clipper/clipper.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 namespace mbgl {
 
-static double signedArea(const GeometryCoordinates& ring) {
+FeatureValue GeometryTileLayerKeys::getValue(const GeometryTileFeature& feature, const std::string& key) {
+    auto it = std::find_if(slots.begin(), slots.end(), [&] (const Slot& slot) {
+        return slot.key == &key;
+    });
+
+    if (it == slots.end()) {
+        it = slots.insert(slots.end(), { &key, feature.getKeyIndex(key), key });
+    }
+
+    // Fails for a key that was destroyed and whose address was reused by another one.
+    assert(it->name == key);
+
+    if (it->index) {
+        return feature.getIndexedValue(*it->index);
+    } else {
+        return feature.lookupValue(key);
+    }
+}
+
+void GeometryTileFeature::visitGeometries(GeometryCoordinates&,
+                                          const std::function<void (const GeometryCoordinates&)>& visitor) const {
+    for (const auto& line : getGeometries()) {
+        visitor(line);
+    }
+}
+
+const GeometryTileFeature& GeometryTileLayer::makeFeature(std::size_t i, util::MonotonicArena& arena) const {
+    return **arena.make<std::unique_ptr<GeometryTileFeature>>(getFeature(i));
+}
+
+double signedArea(const GeometryCoordinates& ring) {
     double sum = 0;
 
     for (std::size_t i = 0, len = ring.size(), j = len - 1; i < len; j = i++) {
@@ -5,14 +5,20 @@
 #include <mbgl/util/optional.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace mbgl {
 
 class CanonicalTileID;
 
+namespace util {
+class MonotonicArena;
+} // namespace util
+
 // Normalized vector tile coordinates.
 // Each geometry coordinate represents a point in a bidimensional space,
 // varying from -V...0...+V, where V is the maximum extent applicable.
@@ -30,14 +36,64 @@ public:
     using std::vector<GeometryCoordinates>::vector;
 };
 
+// Index of a property key in the key table shared by the features of a vector tile layer.
+using KeyIndex = uint32_t;
+
+// A property value of a feature, or none. Refers to the value when the feature keeps it in a
+// form that can be read in place, so that reading e.g. a string property doesn't copy it, and
+// holds a copy otherwise. A reference is valid for as long as the feature it was read from.
+class FeatureValue {
+public:
+    FeatureValue() = default;
+    FeatureValue(const Value* value_) : value(value_) {}
+    FeatureValue(optional<Value> copy_)
+        : copy(std::move(copy_)), value(copy ? &*copy : nullptr) {}
+
+    FeatureValue(const FeatureValue& other)
+        : copy(other.copy), value(other.copy ? &*copy : other.value) {}
+    FeatureValue(FeatureValue&& other)
+        : copy(std::move(other.copy)), value(copy ? &*copy : other.value) {}
+
+    FeatureValue& operator=(const FeatureValue&) = delete;
+
+    explicit operator bool() const { return value; }
+    const Value& operator*() const { return *value; }
+    const Value* operator->() const { return value; }
+
+    optional<Value> toOptional() const {
+        return value ? optional<Value>(*value) : optional<Value>();
+    }
+
+private:
+    optional<Value> copy;
+    const Value* value = nullptr;
+};
+
 class GeometryTileFeature {
 public:
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
+
+    // Like getValue(), but features that keep their property values refer to the value
+    // instead of copying it.
+    virtual FeatureValue lookupValue(const std::string& key) const { return getValue(key); }
+
+    // Features that share a key table with the rest of their layer resolve a key to its index
+    // in that table, which is the same for every feature of the layer, and look up values with
+    // getIndexedValue() without hashing the key again. Other features return nullopt.
+    virtual optional<KeyIndex> getKeyIndex(const std::string&) const { return {}; }
+    virtual const Value* getIndexedValue(KeyIndex) const { return nullptr; }
+
     virtual PropertyMap getProperties() const { return PropertyMap(); }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
     virtual GeometryCollection getGeometries() const = 0;
+
+    // Calls the visitor with each line or ring of getGeometries() in turn. Features that can
+    // decode their geometry one line at a time do so into `buffer`, which callers reuse for
+    // all features to avoid allocating a GeometryCollection for each of them.
+    virtual void visitGeometries(GeometryCoordinates& buffer,
+                                 const std::function<void (const GeometryCoordinates&)>& visitor) const;
 };
 
 class GeometryTileLayer {
@@ -46,15 +102,77 @@ public:
     virtual std::size_t featureCount() const = 0;
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
     virtual std::string getName() const = 0;
+
+    // Like getFeature(), but makes the feature in the given arena, where it lives until the
+    // arena is reset. Layers that can construct their features in place do so without a heap
+    // allocation per feature.
+    virtual const GeometryTileFeature& makeFeature(std::size_t, util::MonotonicArena&) const;
 };
 
+// Looks up property values of the features of one layer, resolving each key to a slot the
+// first time it is used. Filters and data-driven properties ask for the same few keys for every
+// feature, and always pass the same string: the key of the filter or the property of the
+// function. Slots are found by the address of that string, so after the first feature a lookup
+// compares no strings, only the key index with the feature's tags.
+//
+// Keys must therefore outlive this object, as those of the layers it lays out do. Look up keys
+// that are made for the occasion, such as those of tokens, on the feature instead.
+class GeometryTileLayerKeys {
+public:
+    FeatureValue getValue(const GeometryTileFeature&, const std::string& key);
+
+private:
+    struct Slot {
+        const std::string* key;
+        optional<KeyIndex> index;
+        std::string name;
+    };
+
+    std::vector<Slot> slots;
+};
+
+// Forwards to a feature, looking up property values through the keys of its layer, so the
+// keys passed to it must outlive them.
+class KeyedGeometryTileFeature : public GeometryTileFeature {
+public:
+    KeyedGeometryTileFeature(const GeometryTileFeature& feature_, GeometryTileLayerKeys& keys_)
+        : feature(feature_), keys(keys_) {
+    }
+
+    FeatureType getType() const override { return feature.getType(); }
+    optional<Value> getValue(const std::string& key) const override { return keys.getValue(feature, key).toOptional(); }
+    FeatureValue lookupValue(const std::string& key) const override { return keys.getValue(feature, key); }
+    PropertyMap getProperties() const override { return feature.getProperties(); }
+    optional<FeatureIdentifier> getID() const override { return feature.getID(); }
+    GeometryCollection getGeometries() const override { return feature.getGeometries(); }
+
+    void visitGeometries(GeometryCoordinates& buffer,
+                         const std::function<void (const GeometryCoordinates&)>& visitor) const override {
+        feature.visitGeometries(buffer, visitor);
+    }
+
+private:
+    const GeometryTileFeature& feature;
+    GeometryTileLayerKeys& keys;
+};
+
+// Tile data doesn't change once it has been constructed. It is shared between the tile worker,
+// which lays it out again after every style change, and the tile, which queries it, so reading
+// it must be safe from both threads at once.
 class GeometryTileData {
 public:
     virtual ~GeometryTileData() = default;
-    virtual std::unique_ptr<GeometryTileData> clone() const = 0;
     virtual const GeometryTileLayer* getLayer(const std::string&) const = 0;
+
+    // Whether the other data is known to have the same contents, e.g. because both were
+    // loaded from the same response. Tiles overscaled from the same canonical tile use it
+    // to share their data and layouts.
+    virtual bool sameContents(const GeometryTileData& other) const { return this == &other; }
 };
 
+// Twice the area of a ring; the sign gives its winding order.
+double signedArea(const GeometryCoordinates&);
+
 // classifies an array of rings into polygons with outer rings and holes
 std::vector<GeometryCollection> classifyRings(const GeometryCollection&);
 
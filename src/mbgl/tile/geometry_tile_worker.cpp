@@ -15,6 +15,9 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/parallel_for.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
 
 #include <unordered_set>
 
@@ -25,13 +28,21 @@ using namespace style;
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
                                        OverscaledTileID id_,
+                                       std::string sourceID_,
                                        GlyphAtlas& glyphAtlas_,
+                                       LayoutCache& layoutCache_,
+                                       Scheduler& scheduler_,
+                                       const std::atomic<bool>& parallelLayout_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(std::move(id_)),
+      sourceID(std::move(sourceID_)),
       glyphAtlas(glyphAtlas_),
+      layoutCache(layoutCache_),
+      scheduler(scheduler_),
+      parallelLayout(parallelLayout_),
       obsolete(obsolete_),
       mode(mode_) {
 }
@@ -73,10 +84,12 @@ GeometryTileWorker::~GeometryTileWorker() {
    since it will trigger placement when complete), or return to the [idle] state if not.
 */
 
-void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
+void GeometryTileWorker::setData(std::shared_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
     try {
-        data = std::move(data_);
+        // Tiles overscaled from the same canonical tile lay out the same data once.
+        data = layoutCache.shareData(sourceID, id.canonical, std::move(data_));
         correlationID = correlationID_;
+        layoutGroups.clear();
 
         switch (state) {
         case Idle:
@@ -204,6 +217,11 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
+    // The features of the previous symbol layouts live in the arena. Its memory is given back
+    // rather than kept for the next layout, which may be a long time away.
+    symbolLayouts.clear();
+    layoutArena.release();
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->is<SymbolLayer>()) {
@@ -216,6 +234,19 @@ void GeometryTileWorker::redoLayout() {
     auto featureIndex = std::make_unique<FeatureIndex>();
     BucketParameters parameters { id, mode };
 
+    // Groups whose layers haven't changed since the last layout are kept.
+    std::unordered_map<std::string, std::shared_ptr<const LayoutGroup>> previousLayoutGroups = std::move(layoutGroups);
+    layoutGroups.clear();
+
+    // Non-symbol groups of this layout, in style order.
+    struct NonSymbolGroup {
+        const std::vector<const Layer*>& group;
+        const GeometryTileLayer& geometryLayer;
+        std::string key;
+        std::shared_ptr<const LayoutGroup> layoutGroup;
+    };
+    std::vector<NonSymbolGroup> nonSymbolGroups;
+
     std::vector<std::vector<const Layer*>> groups = groupByLayout(*layers);
     for (auto& group : groups) {
         if (obsolete) {
@@ -242,34 +273,74 @@ void GeometryTileWorker::redoLayout() {
 
         if (leader.is<SymbolLayer>()) {
             symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer));
+                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer, *featureIndex, layoutArena));
         } else {
-            const Filter& filter = leader.baseImpl->filter;
-            const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
-            std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
+            std::string key = bucketKey(group);
+            if (bucketDependsOnOverscaledZoom(group)) {
+                key += "@" + util::toString(id.overscaledZ);
+            }
+
+            // Reuse the group from the last layout, or from another tile of the same data.
+            std::shared_ptr<const LayoutGroup> layoutGroup;
+            auto previous = previousLayoutGroups.find(key);
+            if (previous != previousLayoutGroups.end()) {
+                layoutGroup = std::move(previous->second);
+            } else {
+                layoutGroup = layoutCache.getGroup(**data, key);
+            }
+
+            nonSymbolGroups.push_back({ group, *geometryLayer, std::move(key), std::move(layoutGroup) });
+        }
+    }
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+    std::vector<NonSymbolGroup*> newGroups;
+    for (auto& nonSymbolGroup : nonSymbolGroups) {
+        if (!nonSymbolGroup.layoutGroup) {
+            newGroups.push_back(&nonSymbolGroup);
+        }
+    }
 
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
-                    continue;
+    // Groups are independent of each other, so they can be laid out on several threads.
+    const auto layOut = [&] (std::size_t i) {
+        NonSymbolGroup& newGroup = *newGroups[i];
+        if (auto layoutGroup = createLayoutGroup(newGroup.group, newGroup.geometryLayer, parameters)) {
+            newGroup.layoutGroup = layoutCache.addGroup(newGroup.key, std::move(layoutGroup));
+        }
+    };
 
-                GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
-            }
+    if (parallelLayout && newGroups.size() > 1) {
+        util::parallelFor(scheduler, newGroups.size(), layOut);
+    } else {
+        for (std::size_t i = 0; i < newGroups.size(); ++i) {
+            layOut(i);
+        }
+    }
 
-            if (!bucket->hasData()) {
-                continue;
-            }
+    if (obsolete) {
+        return; // Some groups may not have been laid out.
+    }
 
-            for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+    for (auto& nonSymbolGroup : nonSymbolGroups) {
+        const Layer& leader = *nonSymbolGroup.group.at(0);
+        const uint16_t sourceLayerName = featureIndex->internName(leader.baseImpl->sourceLayer);
+        const uint16_t bucketName = featureIndex->internName(leader.getID());
+
+        const LayoutGroup& layoutGroup = *nonSymbolGroup.layoutGroup;
+        for (const auto& indexed : layoutGroup.indexedFeatures) {
+            featureIndex->insert(indexed.first, indexed.second, sourceLayerName, bucketName);
+        }
+
+        if (layoutGroup.hasData) {
+            for (const auto& layer : nonSymbolGroup.group) {
+                buckets.emplace(layer->getID(), layoutGroup.bucket);
             }
         }
+
+        layoutGroups.emplace(std::move(nonSymbolGroup.key), std::move(nonSymbolGroup.layoutGroup));
     }
 
-    symbolLayouts.clear();
+    featureIndex->build();
+
     for (const auto& symbolLayerID : symbolOrder) {
         auto it = symbolLayoutMap.find(symbolLayerID);
         if (it != symbolLayoutMap.end()) {
@@ -280,13 +351,54 @@ void GeometryTileWorker::redoLayout() {
     parent.invoke(&GeometryTile::onLayout, GeometryTile::LayoutResult {
         std::move(buckets),
         std::move(featureIndex),
-        *data ? (*data)->clone() : nullptr,
+        *data,
         correlationID
     });
 
     attemptPlacement();
 }
 
+std::shared_ptr<LayoutGroup> GeometryTileWorker::createLayoutGroup(const std::vector<const Layer*>& group,
+                                                                 const GeometryTileLayer& geometryLayer,
+                                                                 const BucketParameters& parameters) const {
+    const Layer& leader = *group.at(0);
+    const Filter& filter = leader.baseImpl->filter;
+
+    auto layoutGroup = std::make_shared<LayoutGroup>();
+    layoutGroup->data = *data;
+
+    std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
+    GeometryTileLayerKeys keys;
+    GeometryCoordinates geometryBuffer;
+
+    // Only one feature is needed at a time, so a small arena of the group's own that is reset
+    // for each feature holds them. Groups may be laid out on several threads at once.
+    util::MonotonicArena featureArena(1024);
+
+    for (std::size_t i = 0; !obsolete && i < geometryLayer.featureCount(); i++) {
+        featureArena.reset();
+        const GeometryTileFeature& feature = geometryLayer.makeFeature(i, featureArena);
+        const KeyedGeometryTileFeature keyedFeature(feature, keys);
+
+        if (!filter(feature.getType(), feature.getID(), [&] (const auto& key) { return keys.getValue(feature, key); }))
+            continue;
+
+        feature.visitGeometries(geometryBuffer, [&] (const GeometryCoordinates& geometry) {
+            bucket->addGeometry(geometry);
+            layoutGroup->indexedFeatures.emplace_back(mapbox::geometry::envelope(geometry), uint32_t(i));
+        });
+        bucket->finishFeature(keyedFeature);
+    }
+
+    if (obsolete) {
+        return nullptr; // Don't keep a partially built bucket.
+    }
+
+    layoutGroup->hasData = bucket->hasData();
+    layoutGroup->bucket = std::move(bucket);
+    return layoutGroup;
+}
+
 bool GeometryTileWorker::hasPendingSymbolDependencies() const {
     bool result = false;
 
@@ -316,7 +428,8 @@ void GeometryTileWorker::attemptPlacement() {
             if (symbolLayout->canPrepare(glyphAtlas)) {
                 symbolLayout->state = SymbolLayout::Prepared;
                 symbolLayout->prepare(reinterpret_cast<uintptr_t>(this),
-                                      glyphAtlas);
+                                      glyphAtlas,
+                                      layoutArena);
             } else {
                 canPlace = false;
             }
@@ -5,20 +5,29 @@
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/tile/layout_cache.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
 
 #include <atomic>
 #include <memory>
 #include <unordered_map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
+class Bucket;
 class GeometryTile;
 class GeometryTileData;
+class GeometryTileLayer;
 class GlyphAtlas;
+class Scheduler;
 class SymbolLayout;
 
 namespace style {
 class Layer;
+class BucketParameters;
 } // namespace style
 
 class GeometryTileWorker {
@@ -26,13 +35,17 @@ public:
     GeometryTileWorker(ActorRef<GeometryTileWorker> self,
                        ActorRef<GeometryTile> parent,
                        OverscaledTileID,
+                       std::string sourceID,
                        GlyphAtlas&,
-                       const std::atomic<bool>&,
+                       LayoutCache&,
+                       Scheduler&,
+                       const std::atomic<bool>& parallelLayout,
+                       const std::atomic<bool>& obsolete,
                        const MapMode);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<std::unique_ptr<style::Layer>>, uint64_t correlationID);
-    void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
+    void setData(std::shared_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
     void symbolDependenciesChanged();
 
@@ -40,6 +53,9 @@ private:
     void coalesce();
     void coalesced();
     void redoLayout();
+    std::shared_ptr<LayoutGroup> createLayoutGroup(const std::vector<const style::Layer*>&,
+                                                   const GeometryTileLayer&,
+                                                   const style::BucketParameters&) const;
     void attemptPlacement();
     bool hasPendingSymbolDependencies() const;
 
@@ -47,7 +63,11 @@ private:
     ActorRef<GeometryTile> parent;
 
     const OverscaledTileID id;
+    const std::string sourceID;
     GlyphAtlas& glyphAtlas;
+    LayoutCache& layoutCache;
+    Scheduler& scheduler;
+    const std::atomic<bool>& parallelLayout;
     const std::atomic<bool>& obsolete;
     const MapMode mode;
 
@@ -63,10 +83,19 @@ private:
 
     // Outer optional indicates whether we've received it or not.
     optional<std::vector<std::unique_ptr<style::Layer>>> layers;
-    optional<std::unique_ptr<const GeometryTileData>> data;
+    optional<std::shared_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
+    // Holds the features of the symbol layouts and the temporaries of shaping their text. The
+    // features are read again on every placement, so the arena lives as long as the layouts
+    // and is released along with them.
+    util::MonotonicArena layoutArena;
     std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+
+    // Non-symbol layer groups of the last layout. Groups of layers with the same bucket key in
+    // the next layout keep them. Keyed by style::bucketKey(), along with the overscaled zoom
+    // level for buckets that depend on it. Cleared when the tile data changes.
+    std::unordered_map<std::string, std::shared_ptr<const LayoutGroup>> layoutGroups;
 };
 
 } // namespace mbgl
@@ -0,0 +1,90 @@
+#include <mbgl/tile/layout_cache.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+// Removes the entries of tiles that are gone once the map has doubled in size since it was
+// last pruned, so that pruning takes amortized constant time.
+template <class Map>
+void LayoutCache::prune(Map& map, std::size_t& pruneSize) {
+    if (map.size() <= pruneSize) {
+        return;
+    }
+
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->second.expired()) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    pruneSize = std::max<std::size_t>(2 * map.size(), 64);
+}
+
+std::shared_ptr<const GeometryTileData> LayoutCache::shareData(const std::string& sourceID,
+                                                               const CanonicalTileID& tileID,
+                                                               std::shared_ptr<const GeometryTileData> tileData) {
+    if (!tileData) {
+        return tileData;
+    }
+
+    const auto key = std::make_pair(sourceID, tileID);
+    std::shared_ptr<const GeometryTileData> shared;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = data.find(key);
+            std::shared_ptr<const GeometryTileData> current = it != data.end() ? it->second.lock() : nullptr;
+            if (current == shared) {
+                // There is nothing left to share: no tile uses the previous data anymore, or it
+                // has been reloaded with new contents.
+                if (it != data.end()) {
+                    it->second = tileData;
+                } else {
+                    data.emplace(key, tileData);
+                    prune(data, dataPruneSize);
+                }
+                return tileData;
+            }
+            shared = std::move(current);
+        }
+
+        // Comparing the contents may read both tiles in full, so it happens without holding
+        // the lock. If another tile replaced the entry in the meantime, compare with that one.
+        if (shared->sameContents(*tileData)) {
+            return shared;
+        }
+    }
+}
+
+std::shared_ptr<const LayoutGroup> LayoutCache::getGroup(const GeometryTileData& tileData, const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = groups.find({ &tileData, key });
+    return it != groups.end() ? it->second.lock() : nullptr;
+}
+
+std::shared_ptr<const LayoutGroup> LayoutCache::addGroup(const std::string& key, std::shared_ptr<const LayoutGroup> group) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Groups keep their data alive, so the address isn't reused as long as the entry is.
+    auto result = groups.emplace(std::make_pair(group->data.get(), key), group);
+    if (!result.second) {
+        std::shared_ptr<const LayoutGroup> existing = result.first->second.lock();
+        if (existing) {
+            return existing;
+        }
+        result.first->second = group;
+    } else {
+        prune(groups, groupsPruneSize);
+    }
+
+    return group;
+}
+
+} // namespace mbgl
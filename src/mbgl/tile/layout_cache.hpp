@@ -0,0 +1,59 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+class Bucket;
+class GeometryTileData;
+
+// A non-symbol bucket, along with the feature index entries of its features. It doesn't
+// change once it has been laid out, so tiles can share it with each other.
+class LayoutGroup {
+public:
+    std::shared_ptr<const GeometryTileData> data;
+    std::shared_ptr<Bucket> bucket;
+    bool hasData = false;
+    std::vector<std::pair<FeatureIndex::Envelope, uint32_t>> indexedFeatures;
+};
+
+// Lets the tiles of a style that are overscaled from the same canonical tile share its data
+// and the layer groups laid out from it, instead of each parsing and laying out a copy. It
+// only holds weak references, so entries go away with the last tile using them. Workers of
+// all tiles use it at the same time.
+class LayoutCache {
+public:
+    // Returns data with the same contents that another tile of the source already uses, or
+    // the given data if there is none.
+    std::shared_ptr<const GeometryTileData> shareData(const std::string& sourceID,
+                                                      const CanonicalTileID&,
+                                                      std::shared_ptr<const GeometryTileData>);
+
+    std::shared_ptr<const LayoutGroup> getGroup(const GeometryTileData&, const std::string& key);
+
+    // Returns the group that another tile added for the same key in the meantime, if any,
+    // and the given group otherwise.
+    std::shared_ptr<const LayoutGroup> addGroup(const std::string& key, std::shared_ptr<const LayoutGroup>);
+
+private:
+    template <class Map>
+    static void prune(Map&, std::size_t& pruneSize);
+
+    std::mutex mutex;
+
+    std::map<std::pair<std::string, CanonicalTileID>, std::weak_ptr<const GeometryTileData>> data;
+    std::size_t dataPruneSize = 0;
+
+    std::map<std::pair<const GeometryTileData*, std::string>, std::weak_ptr<const LayoutGroup>> groups;
+    std::size_t groupsPruneSize = 0;
+};
+
+} // namespace mbgl
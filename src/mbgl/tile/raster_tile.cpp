@@ -59,4 +59,12 @@ void RasterTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterTile::setPriority(Scheduler::Priority priority) {
+    worker.setPriority(priority);
+}
+
+void RasterTile::setRequestPriority(uint32_t priority) {
+    loader.setPriority(priority);
+}
+
 } // namespace mbgl
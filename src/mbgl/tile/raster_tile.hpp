@@ -22,6 +22,8 @@ public:
     ~RasterTile() final;
 
     void setNecessity(Necessity) final;
+    void setPriority(Scheduler::Priority) final;
+    void setRequestPriority(uint32_t) final;
 
     void setError(std::exception_ptr);
     void setData(std::shared_ptr<const std::string> data,
@@ -9,6 +9,7 @@
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 #include <string>
 #include <memory>
@@ -44,12 +45,22 @@ public:
 
     virtual void setNecessity(Necessity) = 0;
 
+    // Hints how urgently pending parsing and layout work for this tile should be
+    // processed, relative to the work of other tiles.
+    virtual void setPriority(Scheduler::Priority) {}
+
+    // Orders the network request for this tile among the ones waiting for a connection.
+    // Lower values are loaded first.
+    virtual void setRequestPriority(uint32_t) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
     virtual Bucket* getBucket(const style::Layer&) = 0;
 
-    virtual void setPlacementConfig(const PlacementConfig&) {}
+    // While the camera is moving, a tile may keep a placement that is close to the requested
+    // config. Once it stops, symbols are placed for exactly the requested config.
+    virtual void setPlacementConfig(const PlacementConfig&, bool /* cameraIsMoving */) {}
     virtual void symbolDependenciesChanged() {};
     virtual void redoLayout() {}
 
@@ -37,6 +37,8 @@ public:
         }
     }
 
+    void setPriority(uint32_t priority);
+
 private:
     // called when the tile is one of the ideal tiles that we want to show definitely. the tile source
     // should try to make every effort (e.g. fetch from internet, or revalidate existing resources).
@@ -47,6 +47,16 @@ TileLoader<T>::TileLoader(T& tile_,
 template <typename T>
 TileLoader<T>::~TileLoader() = default;
 
+template <typename T>
+void TileLoader<T>::setPriority(uint32_t priority) {
+    if (priority != resource.priority) {
+        resource.priority = priority;
+        if (request) {
+            fileSource.setPriority(*request, priority);
+        }
+    }
+}
+
 template <typename T>
 void TileLoader<T>::loadOptional() {
     assert(!request);
@@ -0,0 +1,293 @@
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/monotonic_arena.hpp>
+
+namespace mbgl {
+
+static Value parseValue(protozero::pbf_reader data) {
+    while (data.next())
+    {
+        switch (data.tag()) {
+        case 1: // string_value
+            return data.get_string();
+        case 2: // float_value
+            return static_cast<double>(data.get_float());
+        case 3: // double_value
+            return data.get_double();
+        case 4: // int_value
+            return data.get_int64();
+        case 5: // uint_value
+            return data.get_uint64();
+        case 6: // sint_value
+            return data.get_sint64();
+        case 7: // bool_value
+            return data.get_bool();
+        default:
+            data.skip();
+            break;
+        }
+    }
+    return false;
+}
+
+VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, std::shared_ptr<VectorTileLayerData> layerData_)
+    : layerData(std::move(layerData_)) {
+    while (feature_pbf.next()) {
+        switch (feature_pbf.tag()) {
+        case 1: // id
+            id = { feature_pbf.get_uint64() };
+            break;
+        case 2: // tags
+            tags_iter = feature_pbf.get_packed_uint32();
+            break;
+        case 3: // type
+            type = static_cast<FeatureType>(feature_pbf.get_enum());
+            break;
+        case 4: // geometry
+            geometry_iter = feature_pbf.get_packed_uint32();
+            break;
+        default:
+            feature_pbf.skip();
+            break;
+        }
+    }
+}
+
+optional<Value> VectorTileFeature::getValue(const std::string& key) const {
+    return lookupValue(key).toOptional();
+}
+
+FeatureValue VectorTileFeature::lookupValue(const std::string& key) const {
+    return getIndexedValue(*getKeyIndex(key));
+}
+
+optional<KeyIndex> VectorTileFeature::getKeyIndex(const std::string& key) const {
+    auto keyIter = layerData->keysMap.find(key);
+    if (keyIter == layerData->keysMap.end()) {
+        // Keys that don't occur in the layer resolve past the end of the key table, which
+        // no feature references.
+        return KeyIndex(layerData->keys.size());
+    }
+    return keyIter->second;
+}
+
+const Value* VectorTileFeature::getIndexedValue(KeyIndex key) const {
+    if (key >= layerData->keys.size()) {
+        return nullptr;
+    }
+
+    auto start_itr = tags_iter.begin();
+    const auto & end_itr = tags_iter.end();
+    while (start_itr != end_itr) {
+        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
+
+        if (layerData->keysMap.size() <= tag_key) {
+            throw std::runtime_error("feature referenced out of range key");
+        }
+
+        if (start_itr == end_itr) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);;
+        if (layerData->values.size() <= tag_val) {
+            throw std::runtime_error("feature referenced out of range value");
+        }
+
+        if (tag_key == key) {
+            return &layerData->getValue(tag_val);
+        }
+    }
+
+    return nullptr;
+}
+
+std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
+    std::unordered_map<std::string,Value> properties;
+    auto start_itr = tags_iter.begin();
+    const auto & end_itr = tags_iter.end();
+    while (start_itr != end_itr) {
+        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
+        if (start_itr == end_itr) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
+        properties[layerData->keys.at(tag_key)] = layerData->getValue(tag_val);
+    }
+    return properties;
+}
+
+optional<FeatureIdentifier> VectorTileFeature::getID() const {
+    return id;
+}
+
+// Decodes the geometry commands of a feature into `line`, calling the visitor with each
+// completed line or ring. The visitor may take the line's coordinates.
+template <class Visitor>
+static void decodeGeometry(const packed_iter_type& geometry_iter, float scale,
+                           GeometryCoordinates& line, Visitor&& visitor) {
+    uint8_t cmd = 1;
+    uint32_t length = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+
+    line.clear();
+
+    auto g_itr = geometry_iter.begin();
+    while (g_itr != geometry_iter.end()) {
+        if (length == 0) {
+            uint32_t cmd_length = static_cast<uint32_t>(*g_itr++);
+            cmd = cmd_length & 0x7;
+            length = cmd_length >> 3;
+        }
+
+        --length;
+
+        if (cmd == 1 || cmd == 2) {
+            x += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+            y += protozero::decode_zigzag32(static_cast<uint32_t>(*g_itr++));
+
+            if (cmd == 1 && !line.empty()) { // moveTo
+                visitor(line);
+                line.clear();
+            }
+
+            line.emplace_back(::round(x * scale), ::round(y * scale));
+
+        } else if (cmd == 7) { // closePolygon
+            if (!line.empty()) {
+                line.push_back(line[0]);
+            }
+
+        } else {
+            throw std::runtime_error("unknown command");
+        }
+    }
+
+    if (!line.empty()) {
+        visitor(line);
+    }
+}
+
+GeometryCollection VectorTileFeature::getGeometries() const {
+    const float scale = float(util::EXTENT) / layerData->extent;
+
+    GeometryCollection lines;
+    GeometryCoordinates line;
+
+    decodeGeometry(geometry_iter, scale, line, [&] (GeometryCoordinates& completed) {
+        lines.push_back(std::move(completed));
+    });
+
+    if (lines.empty()) {
+        lines.emplace_back();
+    }
+
+    if (layerData->version >= 2 || type != FeatureType::Polygon) {
+        return lines;
+    }
+
+    return fixupPolygons(lines);
+}
+
+void VectorTileFeature::visitGeometries(GeometryCoordinates& buffer,
+                                        const std::function<void (const GeometryCoordinates&)>& visitor) const {
+    if (layerData->version < 2 && type == FeatureType::Polygon) {
+        // Version 1 polygons may need to be fixed up as a whole.
+        GeometryTileFeature::visitGeometries(buffer, visitor);
+        return;
+    }
+
+    const float scale = float(util::EXTENT) / layerData->extent;
+    decodeGeometry(geometry_iter, scale, buffer, visitor);
+}
+
+VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
+    : data(std::move(data_)) {
+}
+
+const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
+    std::call_once(parsed, [&] {
+        protozero::pbf_reader tile_pbf(*data);
+        while (tile_pbf.next(3)) {
+            VectorTileLayer layer(tile_pbf.get_message(), data);
+            layers.emplace(layer.name, std::move(layer));
+        }
+    });
+
+    auto it = layers.find(name);
+    if (it != layers.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+bool VectorTileData::sameContents(const GeometryTileData& other) const {
+    auto vectorTileData = dynamic_cast<const VectorTileData*>(&other);
+    return vectorTileData
+        && (data == vectorTileData->data || *data == *vectorTileData->data);
+}
+
+VectorTileLayerData::VectorTileLayerData(std::shared_ptr<const std::string> pbfData) :
+    data(std::move(pbfData))
+{}
+
+const Value& VectorTileLayerData::getValue(std::size_t index) {
+    const protozero::pbf_reader& encoded = values.at(index);
+    DecodedValue& decoded = decodedValues[index];
+
+    std::call_once(decoded.decoded, [&] {
+        decoded.value = parseValue(encoded);
+    });
+
+    return *decoded.value;
+}
+
+VectorTileLayer::VectorTileLayer(protozero::pbf_reader layer_pbf, std::shared_ptr<const std::string> pbfData)
+    : data(std::make_shared<VectorTileLayerData>(std::move(pbfData)))
+{
+    while (layer_pbf.next()) {
+        switch (layer_pbf.tag()) {
+        case 1: // name
+            name = layer_pbf.get_string();
+            break;
+        case 2: // feature
+            features.push_back(layer_pbf.get_message());
+            break;
+        case 3: // keys
+            {
+                auto iter = data->keysMap.emplace(layer_pbf.get_string(), data->keysMap.size());
+                data->keys.emplace_back(std::reference_wrapper<const std::string>(iter.first->first));
+            }
+            break;
+        case 4: // values
+            data->values.emplace_back(layer_pbf.get_message());
+            break;
+        case 5: // extent
+            data->extent = layer_pbf.get_uint32();
+            break;
+        case 15: // version
+            data->version = layer_pbf.get_uint32();
+            break;
+        default:
+            layer_pbf.skip();
+            break;
+        }
+    }
+
+    data->decodedValues = std::make_unique<VectorTileLayerData::DecodedValue[]>(data->values.size());
+}
+
+std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
+    return std::make_unique<VectorTileFeature>(features.at(i), data);
+}
+
+const GeometryTileFeature& VectorTileLayer::makeFeature(std::size_t i, util::MonotonicArena& arena) const {
+    return *arena.make<VectorTileFeature>(features.at(i), data);
+}
+
+std::string VectorTileLayer::getName() const {
+    return name;
+}
+
+} // namespace mbgl
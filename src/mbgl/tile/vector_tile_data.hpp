@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <protozero/pbf_reader.hpp>
+
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+#include <utility>
+
+namespace mbgl {
+
+class VectorTileLayer;
+
+using packed_iter_type = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
+
+class VectorTileLayerData {
+public:
+    VectorTileLayerData(std::shared_ptr<const std::string>);
+    
+    // Hold a reference to the underlying pbf data that backs the lazily-built
+    // components of the owning VectorTileLayer and VectorTileFeature objects
+    std::shared_ptr<const std::string> data;
+    
+    uint32_t version = 1;
+    uint32_t extent = 4096;
+    std::unordered_map<std::string, uint32_t> keysMap;
+    std::vector<std::reference_wrapper<const std::string>> keys;
+
+    // Entries of the value table point into `data` and are only decoded when a feature
+    // property is read; styles typically read a few keys of layers with thousands of values.
+    std::vector<protozero::pbf_reader> values;
+    const Value& getValue(std::size_t index);
+
+private:
+    friend class VectorTileLayer;
+
+    // Features of the layer are read on the worker and, for queries, on the main thread.
+    // Each value is decoded once by the first thread that reads it.
+    struct DecodedValue {
+        std::once_flag decoded;
+        optional<Value> value;
+    };
+    std::unique_ptr<DecodedValue[]> decodedValues;
+};
+
+class VectorTileFeature : public GeometryTileFeature {
+public:
+    VectorTileFeature(protozero::pbf_reader, std::shared_ptr<VectorTileLayerData> layerData);
+
+    FeatureType getType() const override { return type; }
+    optional<Value> getValue(const std::string&) const override;
+    FeatureValue lookupValue(const std::string&) const override;
+    optional<KeyIndex> getKeyIndex(const std::string&) const override;
+    const Value* getIndexedValue(KeyIndex) const override;
+    std::unordered_map<std::string,Value> getProperties() const override;
+    optional<FeatureIdentifier> getID() const override;
+    GeometryCollection getGeometries() const override;
+    void visitGeometries(GeometryCoordinates&,
+                         const std::function<void (const GeometryCoordinates&)>&) const override;
+
+private:
+    std::shared_ptr<VectorTileLayerData> layerData;
+    optional<FeatureIdentifier> id;
+    FeatureType type = FeatureType::Unknown;
+    packed_iter_type tags_iter;
+    packed_iter_type geometry_iter;
+};
+    
+class VectorTileLayer : public GeometryTileLayer {
+public:
+    VectorTileLayer(protozero::pbf_reader, std::shared_ptr<const std::string>);
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override;
+    const GeometryTileFeature& makeFeature(std::size_t, util::MonotonicArena&) const override;
+    std::string getName() const override;
+
+private:
+    friend class VectorTileData;
+    friend class VectorTileFeature;
+
+    std::string name;
+    std::vector<protozero::pbf_reader> features;
+    std::shared_ptr<VectorTileLayerData> data;
+};
+
+class VectorTileData : public GeometryTileData {
+public:
+    VectorTileData(std::shared_ptr<const std::string> data);
+
+    const GeometryTileLayer* getLayer(const std::string&) const override;
+    bool sameContents(const GeometryTileData&) const override;
+
+private:
+    std::shared_ptr<const std::string> data;
+
+    // The layer directory is parsed by whichever thread reads a layer first.
+    mutable std::once_flag parsed;
+    mutable std::unordered_map<std::string, VectorTileLayer> layers;
+};
+
+} // namespace mbgl
@@ -2,7 +2,7 @@
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
+#include <cmath>
 
 namespace mbgl {
 
@@ -17,65 +17,55 @@ GridIndex<T>::GridIndex(int32_t extent_, int32_t n_, int32_t padding_) :
     min(-double(padding) / n * extent),
     max(extent + double(padding) / n * extent)
     {
-        cells.resize(d * d);
     }
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    size_t uid = elements.size();
-
-    auto cx1 = convertToCellCoord(bbox.min.x);
-    auto cy1 = convertToCellCoord(bbox.min.y);
-    auto cx2 = convertToCellCoord(bbox.max.x);
-    auto cy2 = convertToCellCoord(bbox.max.y);
-
-    int32_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = d * y + x;
-            cells[cellIndex].push_back(uid);
-        }
-    }
-
-    elements.emplace_back(t, bbox);
+    elements.emplace_back(std::move(t), bbox);
 }
 
 template <class T>
-std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
-    std::vector<T> result;
-    std::unordered_set<size_t> seenUids;
+void GridIndex<T>::build() {
+    // Count the elements in every cell, shifted by one...
+    cellOffsets.assign(d * d + 1, 0);
+    for (const auto& pair : elements) {
+        const auto& bbox = pair.second;
+        auto cx1 = convertToCellCoord(bbox.min.x);
+        auto cy1 = convertToCellCoord(bbox.min.y);
+        auto cx2 = convertToCellCoord(bbox.max.x);
+        auto cy2 = convertToCellCoord(bbox.max.y);
+
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            for (int32_t y = cy1; y <= cy2; ++y) {
+                cellOffsets[d * y + x + 1]++;
+            }
+        }
+    }
 
-    auto cx1 = convertToCellCoord(queryBBox.min.x);
-    auto cy1 = convertToCellCoord(queryBBox.min.y);
-    auto cx2 = convertToCellCoord(queryBBox.max.x);
-    auto cy2 = convertToCellCoord(queryBBox.max.y);
+    // ...turn the counts into offsets...
+    for (std::size_t i = 1; i < cellOffsets.size(); ++i) {
+        cellOffsets[i] += cellOffsets[i - 1];
+    }
 
-    int32_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = d * y + x;
-            for (auto uid : cells[cellIndex]) {
-                if (seenUids.count(uid) == 0) {
-                    seenUids.insert(uid);
+    // ...and fill in the element indices, using a copy of the offsets as insertion points.
+    cellElements.resize(cellOffsets.back());
+    std::vector<uint32_t> next(cellOffsets.begin(), cellOffsets.end() - 1);
 
-                    auto& pair = elements.at(uid);
-                    auto& bbox = pair.second;
-                    if (queryBBox.min.x <= bbox.max.x &&
-                        queryBBox.min.y <= bbox.max.y &&
-                        queryBBox.max.x >= bbox.min.x &&
-                        queryBBox.max.y >= bbox.min.y) {
+    for (std::size_t uid = 0; uid < elements.size(); ++uid) {
+        const auto& bbox = elements[uid].second;
+        auto cx1 = convertToCellCoord(bbox.min.x);
+        auto cy1 = convertToCellCoord(bbox.min.y);
+        auto cx2 = convertToCellCoord(bbox.max.x);
+        auto cy2 = convertToCellCoord(bbox.max.y);
 
-                        result.push_back(pair.first);
-                    }
-                }
+        for (int32_t x = cx1; x <= cx2; ++x) {
+            for (int32_t y = cy1; y <= cy2; ++y) {
+                cellElements[next[d * y + x]++] = uint32_t(uid);
             }
         }
     }
-
-    return result;
 }
 
-
 template <class T>
 int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
     return util::max(0.0, util::min(d - 1.0, std::floor(x * scale) + padding));
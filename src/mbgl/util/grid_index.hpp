@@ -9,6 +9,15 @@
 
 namespace mbgl {
 
+/*
+    A spatial index over a tile that is filled once and queried many times.
+
+    Elements are first collected with `insert`. `build` then packs the cells into two flat
+    arrays in compressed sparse row form: the elements in cell `i` are the entries
+    `cellElements[cellOffsets[i]]` to `cellElements[cellOffsets[i + 1] - 1]`. Building
+    is meant to happen on the worker thread that created the index, so that queries
+    (e.g. for `queryRenderedFeatures` on every mouse move) only read.
+*/
 template <class T>
 class GridIndex {
 public:
@@ -17,7 +26,21 @@ public:
     using BBox = mapbox::geometry::box<int16_t>;
 
     void insert(T&& t, const BBox&);
-    std::vector<T> query(const BBox&) const;
+
+    // Packs the elements inserted so far into the cell arrays. Elements inserted after
+    // the last call to `build` are not found by `query`.
+    void build();
+
+    // Calls `fn(const T&)` once for every element whose bounding box intersects the
+    // query box. Neither allocates nor copies elements.
+    template <class Fn>
+    void query(const BBox&, Fn&&) const;
+
+    // Approximate heap memory held by the index, in bytes.
+    std::size_t byteSize() const {
+        return elements.capacity() * sizeof(std::pair<T, BBox>) +
+               (cellOffsets.capacity() + cellElements.capacity()) * sizeof(uint32_t);
+    }
 
 private:
     int32_t convertToCellCoord(int32_t x) const;
@@ -31,8 +54,48 @@ private:
     const int32_t max;
 
     std::vector<std::pair<T, BBox>> elements;
-    std::vector<std::vector<size_t>> cells;
-
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellElements;
 };
 
+template <class T>
+template <class Fn>
+void GridIndex<T>::query(const BBox& queryBBox, Fn&& fn) const {
+    if (cellOffsets.empty()) {
+        return;
+    }
+
+    auto cx1 = convertToCellCoord(queryBBox.min.x);
+    auto cy1 = convertToCellCoord(queryBBox.min.y);
+    auto cx2 = convertToCellCoord(queryBBox.max.x);
+    auto cy2 = convertToCellCoord(queryBBox.max.y);
+
+    int32_t x, y, cellIndex;
+    for (x = cx1; x <= cx2; ++x) {
+        for (y = cy1; y <= cy2; ++y) {
+            cellIndex = d * y + x;
+            for (uint32_t i = cellOffsets[cellIndex]; i < cellOffsets[cellIndex + 1]; ++i) {
+                auto& pair = elements[cellElements[i]];
+                auto& bbox = pair.second;
+
+                // An element that spans several cells is only reported from the first
+                // of them that is covered by the query.
+                const int32_t firstX = convertToCellCoord(bbox.min.x);
+                const int32_t firstY = convertToCellCoord(bbox.min.y);
+                if (x != (firstX > cx1 ? firstX : cx1) || y != (firstY > cy1 ? firstY : cy1)) {
+                    continue;
+                }
+
+                if (queryBBox.min.x <= bbox.max.x &&
+                    queryBBox.min.y <= bbox.max.y &&
+                    queryBBox.max.x >= bbox.min.x &&
+                    queryBBox.max.y >= bbox.min.y) {
+
+                    fn(pair.first);
+                }
+            }
+        }
+    }
+}
+
 } // namespace mbgl
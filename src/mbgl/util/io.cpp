@@ -22,8 +22,23 @@ void write_file(const std::string &filename, const std::string &data) {
 }
 
 std::string read_file(const std::string &filename) {
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (file.good()) {
+        file.seekg(0, std::ios::end);
+        const auto size = file.tellg();
+        file.clear();
+        file.seekg(0, std::ios::beg);
+        if (size > 0 && file.good()) {
+            // Size the buffer up front and read straight into it, instead of growing a
+            // stringstream and copying its contents out again.
+            std::string data(std::size_t(size), '\0');
+            file.read(&data[0], data.size());
+            data.resize(std::size_t(file.gcount()));
+            return data;
+        }
+
+        // Pipes and FIFOs can't seek, and files in /proc report a size of zero.
+        file.clear();
         std::stringstream data;
         data << file.rdbuf();
         return data.str();
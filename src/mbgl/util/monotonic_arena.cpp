@@ -0,0 +1,79 @@
+#include <mbgl/util/monotonic_arena.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+namespace util {
+
+MonotonicArena::MonotonicArena(std::size_t chunkSize_)
+    : chunkSize(chunkSize_) {
+    assert(chunkSize > 0);
+}
+
+MonotonicArena::~MonotonicArena() {
+    reset();
+}
+
+void* MonotonicArena::allocate(std::size_t size, std::size_t alignment) {
+    void* pointer = next;
+    if (!std::align(alignment, size, pointer, remaining)) {
+        // Chunks at least double, so that a growing round of allocations takes few of them.
+        const std::size_t previous = chunks.empty() ? 0 : chunks.back().size;
+        addChunk(std::max({ chunkSize, 2 * previous, size + alignment }));
+
+        pointer = next;
+        std::align(alignment, size, pointer, remaining);
+        assert(pointer);
+    }
+
+    next = static_cast<char*>(pointer) + size;
+    remaining -= size;
+    return pointer;
+}
+
+void MonotonicArena::reset() {
+    destroyObjects();
+
+    if (chunks.size() > 1) {
+        const std::size_t total = capacity();
+        chunks.clear();
+        addChunk(total);
+    } else if (!chunks.empty()) {
+        next = chunks.front().memory.get();
+        remaining = chunks.front().size;
+    }
+}
+
+void MonotonicArena::release() {
+    destroyObjects();
+
+    chunks.clear();
+    next = nullptr;
+    remaining = 0;
+}
+
+void MonotonicArena::destroyObjects() {
+    // Destroy objects in the reverse order of their construction.
+    for (Destructor* destructor = destructors; destructor; destructor = destructor->next) {
+        destructor->destroy(destructor->object);
+    }
+    destructors = nullptr;
+}
+
+std::size_t MonotonicArena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+void MonotonicArena::addChunk(std::size_t size) {
+    chunks.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+    next = chunks.back().memory.get();
+    remaining = size;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/*
+    Memory for short-lived objects that all go away at the same time, e.g. the temporaries
+    of laying out a tile. Allocating moves a pointer through a chunk of memory; freeing
+    individual allocations does nothing. `reset` destroys the objects made with `make` and
+    makes all memory available again.
+
+    Memory is kept across resets. When a round of allocations didn't fit into one chunk,
+    the next reset replaces all chunks with a single one that is large enough, so that an
+    arena which is reset after every tile stops allocating once it has seen the largest tile.
+
+    An arena must only be used by one thread at a time.
+*/
+class MonotonicArena : private util::noncopyable {
+public:
+    explicit MonotonicArena(std::size_t chunkSize = 16 * 1024);
+    ~MonotonicArena();
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    // Constructs an object that is destroyed on the next reset.
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            destructors = new (allocate(sizeof(Destructor), alignof(Destructor))) Destructor {
+                [] (void* o) { static_cast<T*>(o)->~T(); }, object, destructors
+            };
+        }
+        return object;
+    }
+
+    void reset();
+
+    // Like `reset`, but frees all memory instead of keeping it for the next round.
+    void release();
+
+    // Total size of the chunks.
+    std::size_t capacity() const;
+
+private:
+    void destroyObjects();
+    void addChunk(std::size_t size);
+
+    struct Chunk {
+        std::unique_ptr<char[]> memory;
+        std::size_t size;
+    };
+
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    const std::size_t chunkSize;
+    std::vector<Chunk> chunks;
+    char* next = nullptr;
+    std::size_t remaining = 0;
+    Destructor* destructors = nullptr;
+};
+
+// Lets standard containers allocate from an arena, e.g. node-based ones that are filled and
+// then thrown away as a whole.
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(MonotonicArena& arena_) : arena(&arena_) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template <class U>
+    friend class ArenaAllocator;
+
+    MonotonicArena* arena;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,102 @@
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+class ParallelFor {
+public:
+    ParallelFor(std::size_t count_, const std::function<void (std::size_t)>& fn_)
+        : count(count_), fn(fn_) {
+    }
+
+    // Claims and calls indices until there are none left.
+    void run() {
+        std::size_t index;
+        while ((index = next++) < count) {
+            try {
+                fn(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (++done == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
+            }
+        }
+    }
+
+    // Waits for the calls that other threads have claimed.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return done == count; });
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)>& fn;
+
+    std::atomic<std::size_t> next { 0 };
+    std::atomic<std::size_t> done { 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::exception_ptr error;
+};
+
+class ParallelForHelper {
+public:
+    ParallelForHelper(ActorRef<ParallelForHelper>, ParallelFor& parallelFor_)
+        : parallelFor(parallelFor_) {
+    }
+
+    void run() {
+        parallelFor.run();
+    }
+
+private:
+    ParallelFor& parallelFor;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, const std::function<void (std::size_t)>& fn) {
+    ParallelFor state(count, fn);
+
+    // Helpers that only get to run after all indices have been claimed return right away, and
+    // helpers that haven't run by the time their actor is destroyed never do.
+    const std::size_t helperCount = std::min<std::size_t>(count ? count - 1 : 0,
+                                                          std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::unique_ptr<Actor<ParallelForHelper>>> helpers;
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.emplace_back(std::make_unique<Actor<ParallelForHelper>>(scheduler, state));
+        helpers.back()->invoke(&ParallelForHelper::run);
+    }
+
+    state.run();
+    state.wait();
+}
+
+} // namespace util
+} // namespace mbgl
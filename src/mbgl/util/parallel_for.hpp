@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Calls `fn` with every index from 0 to `count` - 1, spread over the calling thread and up to
+// `count` - 1 actors on the scheduler, and returns once all calls have finished. The calling
+// thread claims indices as well, so this makes progress even when every thread of the
+// scheduler is busy, including when it is called from one of them. Rethrows the first
+// exception thrown by `fn`, after all calls have finished.
+void parallelFor(Scheduler&, std::size_t count, const std::function<void (std::size_t)>& fn);
+
+} // namespace util
+} // namespace mbgl
@@ -2,9 +2,148 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
+// The vector paths below produce the same results as the scalar loops that finish off the
+// last pixels. Multiplying divides by 255 with rounding as ((x + 128) + ((x + 128) >> 8)) >> 8,
+// which equals (x + 127) / 255 for every product of two bytes. Unpremultiplying divides in
+// single precision floating point, whose quotients of the operands here are never rounded up
+// to the next integer, and truncates.
+
+namespace {
+
+#if defined(__AVX2__)
+
+// Premultiplies eight pixels at a time.
+std::size_t premultiplyAVX2(uint8_t* data, std::size_t bytes) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+    const __m256i bias = _mm256_set1_epi16(128);
+
+    const auto multiply = [&] (__m256i x) {
+        const __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+        __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(x, a), bias);
+        t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+        return _mm256_or_si256(_mm256_and_si256(alphaMask, x), _mm256_andnot_si256(alphaMask, t));
+    };
+
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i* pixels = reinterpret_cast<__m256i*>(data + i);
+        const __m256i x = _mm256_loadu_si256(pixels);
+        _mm256_storeu_si256(pixels, _mm256_packus_epi16(multiply(_mm256_unpacklo_epi8(x, zero)),
+                                                        multiply(_mm256_unpackhi_epi8(x, zero))));
+    }
+    return i;
+}
+
+// Unpremultiplies eight pixels at a time.
+std::size_t unpremultiplyAVX2(uint8_t* data, std::size_t bytes) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256 scale = _mm256_set1_ps(255);
+    // Packing interleaves the 128 bit lanes; this puts the pixels back in order.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    // Two pixels with a 32 bit integer per channel.
+    const auto divide = [&] (__m256i c) {
+        const __m256i a = _mm256_shuffle_epi32(c, 0xFF);
+        const __m256 n = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(c), scale),
+                                       _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 1)));
+        const __m256i q = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_div_ps(n, _mm256_cvtepi32_ps(a))), byteMask);
+        const __m256i keep = _mm256_or_si256(alphaMask, _mm256_cmpeq_epi32(a, zero));
+        return _mm256_or_si256(_mm256_and_si256(keep, c), _mm256_andnot_si256(keep, q));
+    };
+
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        const __m128i* pixels = reinterpret_cast<const __m128i*>(data + i);
+        const __m128i lo = _mm_loadu_si128(pixels);
+        const __m128i hi = _mm_loadu_si128(pixels + 1);
+        const __m256i p01 = _mm256_packs_epi32(divide(_mm256_cvtepu8_epi32(lo)),
+                                               divide(_mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8))));
+        const __m256i p23 = _mm256_packs_epi32(divide(_mm256_cvtepu8_epi32(hi)),
+                                               divide(_mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i),
+                            _mm256_permutevar8x32_epi32(_mm256_packus_epi16(p01, p23), order));
+    }
+    return i;
+}
+
+#endif // defined(__AVX2__)
+
+#if defined(__SSE2__)
+
+// Premultiplies four pixels at a time.
+std::size_t premultiplySSE2(uint8_t* data, std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m128i bias = _mm_set1_epi16(128);
+
+    // Two pixels with a 16 bit integer per channel.
+    const auto multiply = [&] (__m128i x) {
+        const __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF);
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, a), bias);
+        t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        return _mm_or_si128(_mm_and_si128(alphaMask, x), _mm_andnot_si128(alphaMask, t));
+    };
+
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i* pixels = reinterpret_cast<__m128i*>(data + i);
+        const __m128i x = _mm_loadu_si128(pixels);
+        _mm_storeu_si128(pixels, _mm_packus_epi16(multiply(_mm_unpacklo_epi8(x, zero)),
+                                                  multiply(_mm_unpackhi_epi8(x, zero))));
+    }
+    return i;
+}
+
+// Unpremultiplies four pixels at a time.
+std::size_t unpremultiplySSE2(uint8_t* data, std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_setr_epi32(0, 0, 0, -1);
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128 scale = _mm_set1_ps(255);
+
+    // One pixel with a 32 bit integer per channel.
+    const auto divide = [&] (__m128i c) {
+        const __m128i a = _mm_shuffle_epi32(c, 0xFF);
+        const __m128 n = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), scale),
+                                    _mm_cvtepi32_ps(_mm_srli_epi32(a, 1)));
+        const __m128i q = _mm_and_si128(_mm_cvttps_epi32(_mm_div_ps(n, _mm_cvtepi32_ps(a))), byteMask);
+        const __m128i keep = _mm_or_si128(alphaMask, _mm_cmpeq_epi32(a, zero));
+        return _mm_or_si128(_mm_and_si128(keep, c), _mm_andnot_si128(keep, q));
+    };
+
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i* pixels = reinterpret_cast<__m128i*>(data + i);
+        const __m128i x = _mm_loadu_si128(pixels);
+        const __m128i lo = _mm_unpacklo_epi8(x, zero);
+        const __m128i hi = _mm_unpackhi_epi8(x, zero);
+        const __m128i p01 = _mm_packs_epi32(divide(_mm_unpacklo_epi16(lo, zero)),
+                                            divide(_mm_unpackhi_epi16(lo, zero)));
+        const __m128i p23 = _mm_packs_epi32(divide(_mm_unpacklo_epi16(hi, zero)),
+                                            divide(_mm_unpackhi_epi16(hi, zero)));
+        _mm_storeu_si128(pixels, _mm_packus_epi16(p01, p23));
+    }
+    return i;
+}
+
+#endif // defined(__SSE2__)
+
+} // namespace
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -12,7 +151,14 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    i += premultiplyAVX2(data + i, dst.bytes() - i);
+#endif
+#if defined(__SSE2__)
+    i += premultiplySSE2(data + i, dst.bytes() - i);
+#endif
+    for (; i < dst.bytes(); i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -32,7 +178,14 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    i += unpremultiplyAVX2(data + i, dst.bytes() - i);
+#endif
+#if defined(__SSE2__)
+    i += unpremultiplySSE2(data + i, dst.bytes() - i);
+#endif
+    for (; i < dst.bytes(); i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -137,3 +137,110 @@ TEST(Actor, NonConcurrentMailbox) {
     test.invoke(&Test::end);
     endedFuture.wait();
 }
+
+TEST(Actor, ManyMailboxes) {
+    // Work is spread over, and stolen between, the pool's threads without
+    // breaking per-mailbox ordering.
+
+    struct Test {
+        int last = 0;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, std::promise<void> promise_)
+            : promise(std::move(promise_))  {
+        }
+
+        void receive(int i) {
+            EXPECT_EQ(i, last + 1);
+            last = i;
+        }
+
+        void end() {
+            promise.set_value();
+        }
+    };
+
+    ThreadPool pool { 4 };
+
+    std::vector<std::future<void>> endedFutures;
+    std::vector<std::unique_ptr<Actor<Test>>> tests;
+
+    for (auto i = 0; i < 100; ++i) {
+        std::promise<void> endedPromise;
+        endedFutures.push_back(endedPromise.get_future());
+        tests.push_back(std::make_unique<Actor<Test>>(pool, std::move(endedPromise)));
+    }
+
+    for (auto i = 1; i <= 10; ++i) {
+        for (auto& test : tests) {
+            test->invoke(&Test::receive, i);
+        }
+    }
+
+    for (auto& test : tests) {
+        test->invoke(&Test::end);
+    }
+
+    for (auto& endedFuture : endedFutures) {
+        endedFuture.wait();
+    }
+}
+
+TEST(Actor, Priority) {
+    // Mailboxes with a higher priority are processed first.
+
+    struct Blocker {
+        Blocker(ActorRef<Blocker>) {}
+
+        void wait(std::promise<void> entered, std::shared_future<void> released) {
+            entered.set_value();
+            released.wait();
+        }
+    };
+
+    struct Test {
+        std::vector<int>& order;
+        std::promise<void> promise;
+
+        Test(ActorRef<Test>, std::vector<int>& order_, std::promise<void> promise_)
+            : order(order_),
+              promise(std::move(promise_)) {
+        }
+
+        void receive(int i) {
+            order.push_back(i);
+            promise.set_value();
+        }
+    };
+
+    ThreadPool pool { 1 };
+    std::vector<int> order;
+
+    std::promise<void> enteredPromise;
+    std::future<void> enteredFuture = enteredPromise.get_future();
+    std::promise<void> releasedPromise;
+
+    Actor<Blocker> blocker(pool);
+    blocker.invoke(&Blocker::wait, std::move(enteredPromise), releasedPromise.get_future().share());
+    enteredFuture.wait();
+
+    std::promise<void> lowPromise;
+    std::future<void> lowFuture = lowPromise.get_future();
+    Actor<Test> low(pool, std::ref(order), std::move(lowPromise));
+    low.setPriority(Scheduler::Priority::Low);
+
+    std::promise<void> highPromise;
+    std::future<void> highFuture = highPromise.get_future();
+    Actor<Test> high(pool, std::ref(order), std::move(highPromise));
+    high.setPriority(Scheduler::Priority::High);
+
+    // Both are queued while the only worker is blocked.
+    low.invoke(&Test::receive, 1);
+    high.invoke(&Test::receive, 2);
+    releasedPromise.set_value();
+
+    lowFuture.wait();
+    highFuture.wait();
+
+    EXPECT_EQ((std::vector<int>{ 2, 1 }), order);
+}
@@ -5,6 +5,7 @@
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
 #include <mbgl/map/map.hpp>
+#include <mbgl/style/layer.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
 #include <mbgl/util/io.hpp>
@@ -85,6 +86,98 @@ TEST(Annotations, FillAnnotation) {
     test.checkRendering("fill_annotation_max_zoom");
 }
 
+TEST(Annotations, BatchedLineAnnotations) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto addLine = [&] (double offset, Color color, float width) {
+        LineAnnotation annotation { LineString<double> {{ { 0, offset }, { 45, 45 + offset } }} };
+        annotation.color = color;
+        annotation.width = { width };
+        return test.map.addAnnotation(annotation);
+    };
+
+    // The layers drawing shape annotations, from bottom to top.
+    auto shapeLayers = [&] {
+        std::vector<std::string> result;
+        for (const auto& layer : test.map.getLayers()) {
+            if (layer->getID().find("com.mapbox.annotations.shape.") == 0) {
+                result.push_back(layer->getID());
+            }
+        }
+        return result;
+    };
+
+    // Lines that only differ in data-driven paint properties share one layer.
+    for (unsigned i = 0; i < 100; ++i) {
+        addLine(i / 10.0, i % 2 ? Color::green() : Color::blue(), 5);
+    }
+    test::render(test.map, test.view);
+    EXPECT_EQ(std::vector<std::string>({ "com.mapbox.annotations.shape.0" }), shapeLayers());
+
+    // A different line width needs another layer.
+    addLine(0, Color::red(), 10);
+    test::render(test.map, test.view);
+    EXPECT_EQ(std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                         "com.mapbox.annotations.shape.1" }), shapeLayers());
+
+    // Lines are only added to the topmost layer, so they are still drawn above older lines.
+    addLine(0, Color::red(), 5);
+    test::render(test.map, test.view);
+    EXPECT_EQ(std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                         "com.mapbox.annotations.shape.1",
+                                         "com.mapbox.annotations.shape.2" }), shapeLayers());
+}
+
+TEST(Annotations, UpdateKeepsStackingOrder) {
+    AnnotationTest test;
+
+    test.map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto line = [] (Color color, float width) {
+        LineAnnotation annotation { LineString<double> {{ { 0, 0 }, { 45, 45 } }} };
+        annotation.color = color;
+        annotation.width = { width };
+        return annotation;
+    };
+
+    auto shapeLayers = [&] {
+        std::vector<std::string> result;
+        for (const auto& layer : test.map.getLayers()) {
+            if (layer->getID().find("com.mapbox.annotations.shape.") == 0) {
+                result.push_back(layer->getID());
+            }
+        }
+        return result;
+    };
+
+    const AnnotationID a = test.map.addAnnotation(line(Color::red(), 5));
+    test.map.addAnnotation(line(Color::red(), 5));
+    const AnnotationID c = test.map.addAnnotation(line(Color::red(), 10));
+    test::render(test.map, test.view);
+    const std::vector<std::string> layers = { "com.mapbox.annotations.shape.0",
+                                              "com.mapbox.annotations.shape.1" };
+    EXPECT_EQ(layers, shapeLayers());
+
+    // Updates that the layer of an annotation can draw keep it there, below newer annotations.
+    test.map.updateAnnotation(a, line(Color::green(), 5));
+    test::render(test.map, test.view);
+    EXPECT_EQ(layers, shapeLayers());
+
+    // So do updates of an annotation that has a layer of its own.
+    test.map.updateAnnotation(c, line(Color::green(), 2));
+    test::render(test.map, test.view);
+    EXPECT_EQ(layers, shapeLayers());
+
+    // Other updates move the annotation into a layer above.
+    test.map.updateAnnotation(a, line(Color::green(), 8));
+    test::render(test.map, test.view);
+    EXPECT_EQ(std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                         "com.mapbox.annotations.shape.1",
+                                         "com.mapbox.annotations.shape.2" }), shapeLayers());
+}
+
 TEST(Annotations, AntimeridianAnnotationSmall) {
     AnnotationTest test;
 
@@ -0,0 +1,41 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+
+using namespace mbgl;
+
+TEST(FeatureIndex, InternName) {
+    FeatureIndex index;
+
+    const uint16_t water = index.internName("water");
+    const uint16_t roads = index.internName("roads");
+
+    EXPECT_NE(water, roads);
+    EXPECT_EQ(water, index.internName("water"));
+    EXPECT_EQ("water", index.getName(water));
+    EXPECT_EQ("roads", index.getName(roads));
+}
+
+TEST(FeatureIndex, NamesStoredOncePerTile) {
+    const std::string sourceLayer = "a_source_layer_with_a_long_name";
+    const std::string bucket = "a_style_layer_with_an_even_longer_name";
+    const GeometryCollection geometries { GeometryCoordinates { { 0, 0 }, { 10, 10 } } };
+
+    FeatureIndex index;
+    index.setBucketLayerIDs(bucket, { bucket });
+    index.insert(geometries, 0, index.internName(sourceLayer), index.internName(bucket));
+    index.build();
+    const std::size_t one = index.byteSize();
+
+    FeatureIndex many;
+    many.setBucketLayerIDs(bucket, { bucket });
+    for (std::size_t i = 0; i < 1000; ++i) {
+        many.insert(geometries, i, many.internName(sourceLayer), many.internName(bucket));
+    }
+    many.build();
+
+    // Every additional geometry costs a fixed-size entry; the names aren't copied again.
+    EXPECT_EQ(12u, sizeof(IndexedSubfeature));
+    const std::size_t perGeometry = (many.byteSize() - one) / 999;
+    EXPECT_LT(perGeometry, sourceLayer.size() + bucket.size());
+}
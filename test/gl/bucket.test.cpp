@@ -1,4 +1,5 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
 
 #include <mbgl/renderer/circle_bucket.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
@@ -21,6 +22,31 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.hasData());
 }
 
+TEST(Buckets, FillBucketRings) {
+    FillBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    StubGeometryTileFeature feature { {} };
+
+    const GeometryCoordinates outer = { {0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0} };
+    const GeometryCoordinates hole = { {2, 2}, {2, 8}, {8, 8}, {8, 2}, {2, 2} };
+    const GeometryCoordinates second = { {20, 0}, {30, 0}, {30, 10}, {20, 10}, {20, 0} };
+    const GeometryCoordinates empty = { {0, 0}, {5, 0}, {0, 0} };
+
+    // Two polygons, the first one with a hole.
+    bucket.addFeature(feature, { outer, hole, second });
+    EXPECT_EQ(15u, bucket.vertices.vertexSize());
+    ASSERT_EQ(1u, bucket.triangleSegments.size());
+    EXPECT_EQ(30u, bucket.triangleSegments[0].indexLength);
+
+    // Rings without area are skipped, unless they're the only ring of a feature.
+    bucket.addFeature(feature, { empty, second });
+    EXPECT_EQ(20u, bucket.vertices.vertexSize());
+    EXPECT_EQ(36u, bucket.triangleSegments[0].indexLength);
+
+    bucket.addFeature(feature, { empty });
+    EXPECT_EQ(23u, bucket.vertices.vertexSize());
+    EXPECT_EQ(36u, bucket.triangleSegments[0].indexLength);
+}
+
 TEST(Buckets, LineBucket) {
     LineBucket bucket { { {0, 0, 0}, MapMode::Still }, {}, {} };
     ASSERT_FALSE(bucket.hasData());
@@ -504,6 +504,21 @@ TEST(Transform, Camera) {
     ASSERT_FALSE(transform.inTransition());
 }
 
+TEST(Transform, AnimatedPitchIsChanging) {
+    Transform transform;
+    transform.resize({ 1000, 1000 });
+
+    // Tiles keep a close placement only while the camera changes, and tilting changes it.
+    transform.setPitch(30 * util::DEG2RAD, AnimationOptions(Seconds(1)));
+    ASSERT_TRUE(transform.inTransition());
+    EXPECT_TRUE(transform.getState().isChanging());
+
+    transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    EXPECT_FALSE(transform.inTransition());
+    EXPECT_FALSE(transform.getState().isChanging());
+    EXPECT_DOUBLE_EQ(30 * util::DEG2RAD, transform.getPitch());
+}
+
 TEST(Transform, DefaultTransform) {
     Transform transform;
     const TransformState& state = transform.getState();
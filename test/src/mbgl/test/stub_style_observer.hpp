@@ -30,6 +30,10 @@ public:
         if (sourceLoaded) sourceLoaded(source);
     }
 
+    void onSourceChanged(Source& source) override {
+        if (sourceChanged) sourceChanged(source);
+    }
+
     void onSourceAttributionChanged(Source& source, const std::string& attribution) override {
         if (sourceAttributionChanged) sourceAttributionChanged(source, attribution);
     }
@@ -60,6 +64,7 @@ public:
     std::function<void ()> spriteLoaded;
     std::function<void (std::exception_ptr)> spriteError;
     std::function<void (Source&)> sourceLoaded;
+    std::function<void (Source&)> sourceChanged;
     std::function<void (Source&, std::string)> sourceAttributionChanged;
     std::function<void (Source&, std::exception_ptr)> sourceError;
     std::function<void (Source&)> sourceDescriptionChanged;
@@ -307,6 +307,50 @@ TEST(DefaultFileSource, OptionalNotFound) {
     loop.run();
 }
 
+TEST(DefaultFileSource, OptionalMemoryCache) {
+    util::RunLoop loop;
+    DefaultFileSource fs(":memory:", ".");
+
+    const Resource optionalResource { Resource::Unknown, "http://127.0.0.1:3000/test", {}, Resource::Optional };
+
+    // Store the response in the database only.
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+    fs.setMaximumMemoryCacheSize(0);
+    fs.put(optionalResource, response);
+    fs.setMaximumMemoryCacheSize(util::DEFAULT_MAX_MEMORY_CACHE_SIZE);
+
+    std::unique_ptr<AsyncRequest> req;
+    std::shared_ptr<const std::string> data;
+    int responses = 0;
+
+    std::function<void ()> request = [&] {
+        req = fs.request(optionalResource, [&](Response res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Cached value", *res.data);
+
+            if (++responses == 1) {
+                // The first request finds the response in the database.
+                EXPECT_EQ(0u, fs.getMemoryCacheHitCount());
+                EXPECT_EQ(1u, fs.getMemoryCacheMissCount());
+                data = res.data;
+                request();
+            } else {
+                // The second finds it in memory, along with the same data.
+                EXPECT_EQ(1u, fs.getMemoryCacheHitCount());
+                EXPECT_EQ(1u, fs.getMemoryCacheMissCount());
+                EXPECT_EQ(data, res.data);
+                loop.stop();
+            }
+        });
+    };
+
+    request();
+    loop.run();
+}
+
 // Test that we can make a request with etag data that doesn't first try to load
 // from cache like a regular request
 TEST(DefaultFileSource, TEST_REQUIRES_SERVER(NoCacheRefreshEtagNotModified)) {
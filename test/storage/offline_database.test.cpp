@@ -11,6 +11,7 @@
 #include <sqlite3.hpp>
 #include <sqlite3.h>
 #include <thread>
+#include <vector>
 #include <random>
 
 using namespace std::literals::string_literals;
@@ -386,6 +387,45 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ConcurrentUse)) {
     thread2.join();
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ConcurrentReads)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db("test/fixtures/offline_database/offline.db");
+
+    Resource resource { Resource::Style, "http://example.com/" };
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    db.put(resource, response);
+
+    // More threads than read-only connections, so that some of them wait for a connection,
+    // while another thread writes.
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < 2 * OfflineDatabase::maximumReaderCount; i++) {
+        readers.emplace_back([&] {
+            for (auto j = 0; j < 100; j++) {
+                auto result = db.get(resource);
+                ASSERT_TRUE(bool(result));
+                EXPECT_EQ("data", *result->data);
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        Resource other { Resource::Style, "http://example.com/other" };
+        for (auto i = 0; i < 100; i++) {
+            db.put(other, response);
+        }
+    });
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    writer.join();
+}
+
 static std::shared_ptr<std::string> randomString(size_t size) {
     auto result = std::make_shared<std::string>(size, 0);
     std::mt19937 random;
@@ -462,6 +502,130 @@ TEST(OfflineDatabase, PutFailsWhenEvictionInsuffices) {
     EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/big"))));
 }
 
+static int64_t resourceAccessed(const std::string& path, const std::string& url) {
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt = db.prepare("SELECT accessed FROM resources WHERE url = ?1");
+    stmt.bind(1, url);
+    stmt.run();
+    return stmt.get<int64_t>(0);
+}
+
+static void resetResourceAccessed(const std::string& path, const std::string& url) {
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadWrite);
+    db.setBusyTimeout(mbgl::Milliseconds::max());
+    mapbox::sqlite::Statement stmt = db.prepare("UPDATE resources SET accessed = 0 WHERE url = ?1");
+    stmt.bind(1, url);
+    stmt.run();
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AccessTimesAreBuffered)) {
+    using namespace mbgl;
+
+    const std::string path = "test/fixtures/offline_database/offline.db";
+    const Resource resource = Resource::style("http://example.com/");
+
+    createDir("test/fixtures/offline_database");
+    deleteFile(path.c_str());
+
+    {
+        OfflineDatabase db(path);
+        db.setAccessTimeGranularity(Seconds(3600));
+
+        Response response;
+        response.data = std::make_shared<std::string>("data");
+        db.put(resource, response);
+        resetResourceAccessed(path, resource.url);
+
+        EXPECT_TRUE(bool(db.get(resource)));
+        EXPECT_EQ(0, resourceAccessed(path, resource.url));
+    }
+
+    // Closing the database writes the access time, rounded down to the hour.
+    const int64_t accessed = resourceAccessed(path, resource.url);
+    EXPECT_LT(0, accessed);
+    EXPECT_EQ(0, accessed % 3600);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutsDropBufferedAccessTimes)) {
+    using namespace mbgl;
+
+    const std::string path = "test/fixtures/offline_database/offline.db";
+    const Resource resource = Resource::style("http://example.com/");
+
+    createDir("test/fixtures/offline_database");
+    deleteFile(path.c_str());
+
+    {
+        OfflineDatabase db(path);
+        db.setAccessTimeGranularity(Seconds(3600));
+
+        Response response;
+        response.data = std::make_shared<std::string>("data");
+        db.put(resource, response);
+        EXPECT_TRUE(bool(db.get(resource)));
+
+        // The put writes a newer access time than the buffered one, which is dropped.
+        db.put(resource, response);
+        EXPECT_LT(0, resourceAccessed(path, resource.url));
+        resetResourceAccessed(path, resource.url);
+    }
+
+    EXPECT_EQ(0, resourceAccessed(path, resource.url));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AccessTimesAreWrittenRightAwayWithoutGranularity)) {
+    using namespace mbgl;
+
+    const std::string path = "test/fixtures/offline_database/offline.db";
+    const Resource resource = Resource::style("http://example.com/");
+
+    createDir("test/fixtures/offline_database");
+    deleteFile(path.c_str());
+
+    OfflineDatabase db(path);
+    db.setAccessTimeGranularity(Seconds::zero());
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    db.put(resource, response);
+    resetResourceAccessed(path, resource.url);
+
+    EXPECT_TRUE(bool(db.get(resource)));
+    EXPECT_LT(0, resourceAccessed(path, resource.url));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AccessTimesAreWrittenBeforeEviction)) {
+    using namespace mbgl;
+
+    const std::string path = "test/fixtures/offline_database/offline.db";
+    const Resource resource = Resource::style("http://example.com/region");
+
+    createDir("test/fixtures/offline_database");
+    deleteFile(path.c_str());
+
+    OfflineDatabase db(path, 1024 * 100);
+    db.setAccessTimeGranularity(Seconds(3600));
+
+    // Resources of a region aren't evicted, so this one stays around to be looked at.
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Response response;
+    response.data = randomString(1024);
+    db.putRegionResource(region.getID(), resource, response);
+    resetResourceAccessed(path, resource.url);
+
+    EXPECT_TRUE(bool(db.get(resource)));
+    EXPECT_EQ(0, resourceAccessed(path, resource.url));
+
+    for (uint32_t i = 1; i <= 100; i++) {
+        db.put(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+    EXPECT_LT(0, resourceAccessed(path, resource.url));
+}
+
 TEST(OfflineDatabase, GetRegionCompletedStatus) {
     using namespace mbgl;
 
@@ -627,31 +791,24 @@ static std::string databaseJournalMode(const std::string& path) {
     return stmt.get<std::string>(0);
 }
 
-static int databaseSyncMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
-    mapbox::sqlite::Statement stmt = db.prepare("pragma synchronous");
-    stmt.run();
-    return stmt.get<int>(0);
-}
-
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     using namespace mbgl;
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v6.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,18 +817,18 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -679,22 +836,40 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
 
     // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+
+    // Journal mode should be WAL again after migration to v6. The synchronous setting isn't
+    // stored in the database, so it can't be checked here.
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
+}
+
+TEST(OfflineDatabase, MigrateFromV5Schema) {
+    using namespace mbgl;
+
+    // v5.db is a v5 database, migrated from v2, v3 & v4. This database used `journal_mode = DELETE` and `synchronous = FULL`.
+
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v5.db"));
 
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+    {
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
+        auto regions = db.listRegions();
+        for (auto& region : regions) {
+            db.deleteRegion(std::move(region));
+        }
+    }
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
 }
@@ -1,5 +1,6 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/run_loop.hpp>
@@ -10,6 +11,17 @@
 
 using namespace mbgl;
 
+namespace {
+
+// The server counts the requests for each of these URLs, and answers each one after a delay.
+// Every call returns a new URL, so repeated runs start counting from one again.
+Resource coalesceResource(const std::string& test) {
+    static int run = 0;
+    return { Resource::Unknown, "http://127.0.0.1:3000/coalesce/" + test + "-" + std::to_string(++run) };
+}
+
+} // namespace
+
 TEST(OnlineFileSource, Cancel) {
     util::RunLoop loop;
     OnlineFileSource fs;
@@ -45,6 +57,113 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CancelMultiple)) {
     loop.run();
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CoalesceRequests)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const Resource resource = coalesceResource("requests");
+    std::unique_ptr<AsyncRequest> reqs[3];
+    int responses = 0;
+
+    for (int i = 0; i < 3; i++) {
+        reqs[i] = fs.request(resource, [&, i](Response res) {
+            reqs[i].reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Response 1", *res.data);
+            if (++responses == 3) {
+                loop.stop();
+            }
+        });
+    }
+
+    loop.run();
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CoalesceRequestsCancel)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    // Cancelling one of two requests for the same resource leaves the transfer to the other,
+    // so the server only sees a single request.
+    const Resource resource = coalesceResource("cancel");
+
+    std::unique_ptr<AsyncRequest> req1 = fs.request(resource, [&](Response) {
+        ADD_FAILURE() << "Callback should not be called";
+    });
+    std::unique_ptr<AsyncRequest> req2 = fs.request(resource, [&](Response res) {
+        req2.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Response 1", *res.data);
+        loop.stop();
+    });
+
+    util::Timer timer;
+    timer.start(Milliseconds(50), Duration::zero(), [&] {
+        req1.reset();
+    });
+
+    loop.run();
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(PendingRequestPriority)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    // Take up every connection with requests that never get a response.
+    std::vector<std::unique_ptr<AsyncRequest>> blockers;
+    for (uint32_t i = 0; i < HTTPFileSource::maximumConcurrentRequests(); i++) {
+        blockers.push_back(fs.request({ Resource::Unknown, "http://127.0.0.1:3000/stale/" + std::to_string(i) },
+                                      [&](Response) { ADD_FAILURE() << "Callback should not be called"; }));
+    }
+
+    auto resource = [](Resource::Kind kind, int number, uint32_t priority,
+                       Resource::Necessity necessity = Resource::Required) {
+        Resource result { kind, "http://127.0.0.1:3000/load/" + std::to_string(number), {}, necessity };
+        result.priority = priority;
+        return result;
+    };
+
+    const std::vector<Resource> resources = {
+        resource(Resource::Tile, 1, 3),
+        resource(Resource::Tile, 2, 1),
+        resource(Resource::Tile, 3, 2),
+        resource(Resource::Tile, 4, 0, Resource::Optional),
+        resource(Resource::Style, 5, 4),
+        resource(Resource::Glyphs, 6, 4),
+    };
+
+    // Every response frees up another connection, so the queued requests are sent one at a time.
+    std::vector<std::string> responses;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    for (const auto& res : resources) {
+        reqs.push_back(fs.request(res, [&](Response response) {
+            ASSERT_TRUE(response.data.get());
+            responses.push_back(*response.data);
+            if (responses.size() == resources.size()) {
+                loop.stop();
+            } else {
+                blockers.pop_back();
+            }
+        }));
+    }
+
+    // Queued requests can still change their place.
+    util::Timer timer;
+    timer.start(Milliseconds(10), Duration::zero(), [&] {
+        fs.setPriority(*reqs[2], 0);
+        blockers.pop_back();
+    });
+
+    loop.run();
+
+    const std::vector<std::string> expected = {
+        "Request 5", "Request 6", "Request 3", "Request 2", "Request 1", "Request 4",
+    };
+    EXPECT_EQ(expected, responses);
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(TemporaryError)) {
     util::RunLoop loop;
     OnlineFileSource fs;
@@ -0,0 +1,127 @@
+#include <mbgl/storage/response_cache.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl;
+
+namespace {
+
+Response response(std::string data) {
+    Response result;
+    result.data = std::make_shared<std::string>(std::move(data));
+    return result;
+}
+
+} // namespace
+
+TEST(ResponseCache, HitAndMiss) {
+    ResponseCache cache(1024);
+    const Resource resource = Resource::style("http://example.com/");
+
+    EXPECT_FALSE(bool(cache.get(resource)));
+
+    const Response stored = response("data");
+    cache.put(resource, stored);
+
+    auto result = cache.get(resource);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ(stored.data.get(), result->data.get());
+
+    EXPECT_EQ(1u, cache.getHitCount());
+    EXPECT_EQ(1u, cache.getMissCount());
+}
+
+TEST(ResponseCache, Tiles) {
+    ResponseCache cache(1024);
+    const std::string urlTemplate = "http://example.com/{z}/{x}/{y}.png";
+    const Resource tile1 = Resource::tile(urlTemplate, 1, 0, 0, 1, Tileset::Scheme::XYZ);
+    const Resource tile2 = Resource::tile(urlTemplate, 1, 1, 0, 1, Tileset::Scheme::XYZ);
+
+    cache.put(tile1, response("tile"));
+    EXPECT_TRUE(bool(cache.get(tile1)));
+    EXPECT_FALSE(bool(cache.get(tile2)));
+    EXPECT_FALSE(bool(cache.get(Resource::style(urlTemplate))));
+}
+
+TEST(ResponseCache, EvictsLeastRecentlyUsed) {
+    const Resource resource1 = Resource::style("1");
+    const Resource resource2 = Resource::style("2");
+    const Resource resource3 = Resource::style("3");
+
+    // Each entry takes the size of its URL and its data.
+    ResponseCache cache(20);
+    cache.put(resource1, response("123456789"));
+    cache.put(resource2, response("123456789"));
+    EXPECT_EQ(20u, cache.getSize());
+
+    EXPECT_TRUE(bool(cache.get(resource1)));
+    cache.put(resource3, response("123456789"));
+    EXPECT_EQ(20u, cache.getSize());
+
+    EXPECT_TRUE(bool(cache.get(resource1)));
+    EXPECT_FALSE(bool(cache.get(resource2)));
+    EXPECT_TRUE(bool(cache.get(resource3)));
+
+    cache.setMaximumSize(10);
+    EXPECT_EQ(10u, cache.getSize());
+    EXPECT_FALSE(bool(cache.get(resource1)));
+    EXPECT_TRUE(bool(cache.get(resource3)));
+}
+
+TEST(ResponseCache, DoesNotStoreOversizedResponses) {
+    ResponseCache cache(10);
+    const Resource resource = Resource::style("1");
+
+    cache.put(resource, response("123456789"));
+    cache.put(resource, response("1234567890"));
+    EXPECT_FALSE(bool(cache.get(resource)));
+    EXPECT_EQ(0u, cache.getSize());
+}
+
+TEST(ResponseCache, Replace) {
+    ResponseCache cache(1024);
+    const Resource resource = Resource::style("http://example.com/");
+
+    cache.put(resource, response("first"));
+    cache.put(resource, response("second"));
+    EXPECT_EQ("second", *cache.get(resource)->data);
+    EXPECT_EQ(resource.url.size() + 6, cache.getSize());
+}
+
+TEST(ResponseCache, DoesNotStoreErrors) {
+    ResponseCache cache(1024);
+    const Resource resource = Resource::style("http://example.com/");
+
+    cache.put(resource, response("data"));
+
+    Response error;
+    error.error = std::make_unique<Response::Error>(Response::Error::Reason::Server);
+    cache.put(resource, error);
+
+    auto result = cache.get(resource);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ(nullptr, result->error);
+    EXPECT_EQ("data", *result->data);
+}
+
+TEST(ResponseCache, NotModifiedUpdatesExpiration) {
+    ResponseCache cache(1024);
+    const Resource resource = Resource::style("http://example.com/");
+
+    Response notModified;
+    notModified.notModified = true;
+    notModified.expires = util::now() + Seconds(100);
+
+    // Without a stored response, there is nothing to update.
+    cache.put(resource, notModified);
+    EXPECT_FALSE(bool(cache.get(resource)));
+
+    cache.put(resource, response("data"));
+    cache.put(resource, notModified);
+
+    auto result = cache.get(resource);
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ("data", *result->data);
+    EXPECT_EQ(notModified.expires, result->expires);
+    EXPECT_FALSE(result->notModified);
+}
@@ -164,6 +164,15 @@ app.get('/delayed', function(req, res) {
     }, 200);
 });
 
+// Counts requests per id, so that tests don't affect each other when they are repeated.
+var coalesceCounters = {};
+app.get('/coalesce/:id', function(req, res) {
+    var counter = coalesceCounters[req.params.id] = (coalesceCounters[req.params.id] || 0) + 1;
+    setTimeout(function() {
+        res.status(200).send('Response ' + counter);
+    }, 200);
+});
+
 
 app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
@@ -0,0 +1,94 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/conversion/geojson_reader.hpp>
+#include <mbgl/util/feature.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+TEST(GeoJSONReader, FeatureCollection) {
+    Result<GeoJSON> result = parseGeoJSON(R"JSON({
+        "type": "FeatureCollection",
+        "features": [{
+            "type": "Feature",
+            "id": 7,
+            "properties": { "name": "a", "tags": [1, -2, 3.5], "nested": { "ok": true } },
+            "geometry": { "type": "Point", "coordinates": [1.5, 2.5, 100] }
+        }, {
+            "geometry": { "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]], "type": "Polygon" },
+            "properties": null,
+            "type": "Feature"
+        }]
+    })JSON");
+
+    ASSERT_TRUE(bool(result));
+    ASSERT_TRUE(result->is<FeatureCollection>());
+    const auto& features = result->get<FeatureCollection>();
+    ASSERT_EQ(2u, features.size());
+
+    const Feature& point = features[0];
+    EXPECT_EQ(FeatureIdentifier(uint64_t(7)), *point.id);
+    EXPECT_EQ(Value(std::string("a")), point.properties.at("name"));
+    EXPECT_EQ(Value(std::vector<Value>{ uint64_t(1), int64_t(-2), 3.5 }), point.properties.at("tags"));
+    EXPECT_EQ(Value(PropertyMap{ { "ok", true } }), point.properties.at("nested"));
+    ASSERT_TRUE(point.geometry.is<mapbox::geometry::point<double>>());
+    EXPECT_EQ((mapbox::geometry::point<double>{ 1.5, 2.5 }), point.geometry.get<mapbox::geometry::point<double>>());
+
+    // "type" may come after "coordinates".
+    const Feature& polygon = features[1];
+    EXPECT_FALSE(bool(polygon.id));
+    ASSERT_TRUE(polygon.geometry.is<mapbox::geometry::polygon<double>>());
+    const auto& rings = polygon.geometry.get<mapbox::geometry::polygon<double>>();
+    ASSERT_EQ(1u, rings.size());
+    EXPECT_EQ(4u, rings[0].size());
+}
+
+TEST(GeoJSONReader, Geometries) {
+    auto parse = [] (const std::string& json) {
+        Result<GeoJSON> result = parseGeoJSON(json);
+        EXPECT_TRUE(bool(result));
+        EXPECT_TRUE(result->is<mapbox::geometry::geometry<double>>());
+        return result->get<mapbox::geometry::geometry<double>>();
+    };
+
+    auto multiLine = parse(R"JSON({ "type": "MultiLineString", "coordinates": [[[0, 0], [1, 1]], [], [[2, 2], [3, 3], [4, 4]]] })JSON");
+    ASSERT_TRUE(multiLine.is<mapbox::geometry::multi_line_string<double>>());
+    const auto& lines = multiLine.get<mapbox::geometry::multi_line_string<double>>();
+    ASSERT_EQ(3u, lines.size());
+    EXPECT_EQ(2u, lines[0].size());
+    EXPECT_EQ(0u, lines[1].size());
+    EXPECT_EQ(3u, lines[2].size());
+    EXPECT_EQ((mapbox::geometry::point<double>{ 4, 4 }), lines[2][2]);
+
+    auto multiPolygon = parse(R"JSON({ "type": "MultiPolygon", "coordinates": [
+        [[[0, 0], [1, 0], [1, 1], [0, 0]]],
+        [[[5, 5], [6, 5], [6, 6], [5, 5]], [[5.2, 5.2], [5.4, 5.2], [5.4, 5.4], [5.2, 5.2]]]
+    ] })JSON");
+    ASSERT_TRUE(multiPolygon.is<mapbox::geometry::multi_polygon<double>>());
+    const auto& polygons = multiPolygon.get<mapbox::geometry::multi_polygon<double>>();
+    ASSERT_EQ(2u, polygons.size());
+    EXPECT_EQ(1u, polygons[0].size());
+    ASSERT_EQ(2u, polygons[1].size());
+    EXPECT_EQ((mapbox::geometry::point<double>{ 5.2, 5.2 }), polygons[1][1][0]);
+
+    auto collection = parse(R"JSON({ "type": "GeometryCollection", "geometries": [
+        { "type": "LineString", "coordinates": [[0, 0], [1, 1]] },
+        { "type": "MultiPoint", "coordinates": [[0, 0]] }
+    ] })JSON");
+    ASSERT_TRUE(collection.is<mapbox::geometry::geometry_collection<double>>());
+    EXPECT_EQ(2u, collection.get<mapbox::geometry::geometry_collection<double>>().size());
+}
+
+TEST(GeoJSONReader, Errors) {
+    // Valid JSON, but not valid GeoJSON.
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "coordinates": [0, 0] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "type": "Unknown", "coordinates": [0, 0] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "type": "Point", "coordinates": [[0, 0]] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "type": "LineString", "coordinates": [[0, 0], 1] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "type": "LineString", "coordinates": [[], [0, 0]] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON({ "type": "FeatureCollection", "features": [{ "type": "Point", "coordinates": [0, 0] }] })JSON")));
+    EXPECT_FALSE(bool(parseGeoJSON(R"JSON([])JSON")));
+
+    // Invalid JSON.
+    EXPECT_THROW(parseGeoJSON(R"JSON({ "type": "Point", )JSON"), std::runtime_error);
+}
@@ -0,0 +1,122 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/sources/geojson_features.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+mapbox::geometry::feature<double> point(double lon, FeatureIdentifier id) {
+    mapbox::geometry::feature<double> feature { mapbox::geometry::point<double>(lon, 0) };
+    feature.id = id;
+    return feature;
+}
+
+std::vector<double> longitudes(const GeoJSONFeatures& features) {
+    std::vector<double> result;
+    for (const auto& feature : features.get()) {
+        result.push_back(feature.geometry.get<mapbox::geometry::point<double>>().x);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(GeoJSONFeatures, ReplaceKeepsOrder) {
+    GeoJSONFeatures features;
+    features.reset(GeoJSON{ FeatureCollection{ point(1, uint64_t(1)), point(2, uint64_t(2)), point(3, uint64_t(3)) } });
+
+    auto changed = features.update({ point(4, uint64_t(2)) }, {});
+    EXPECT_EQ(std::vector<double>({ 1, 4, 3 }), longitudes(features));
+    // The old and the new position.
+    EXPECT_EQ(2u, changed.size());
+
+    features.update({ point(5, uint64_t(5)) }, { uint64_t(1) });
+    EXPECT_EQ(std::vector<double>({ 4, 3, 5 }), longitudes(features));
+
+    // Removing an identifier that doesn't exist changes nothing.
+    changed = features.update({}, { uint64_t(6) });
+    EXPECT_EQ(std::vector<double>({ 4, 3, 5 }), longitudes(features));
+    EXPECT_TRUE(changed.empty());
+}
+
+TEST(GeoJSONFeatures, DuplicateIdentifiers) {
+    GeoJSONFeatures features;
+    features.reset(GeoJSON{ FeatureCollection{
+        point(1, uint64_t(1)), point(2, uint64_t(2)), point(3, uint64_t(1)), point(4, uint64_t(2)) } });
+
+    // All features with the identifier are removed.
+    features.update({}, { uint64_t(1) });
+    EXPECT_EQ(std::vector<double>({ 2, 4 }), longitudes(features));
+
+    // All features with the identifier are replaced by a single one.
+    features.update({ point(5, uint64_t(2)) }, {});
+    EXPECT_EQ(std::vector<double>({ 5 }), longitudes(features));
+
+    // Identifiers of different types don't match.
+    features.update({ point(6, std::string("2")) }, { int64_t(2) });
+    EXPECT_EQ(std::vector<double>({ 5, 6 }), longitudes(features));
+}
+
+TEST(GeoJSONFeatures, RemoveKeepsOrder) {
+    GeoJSONFeatures features;
+    features.reset(GeoJSON{ FeatureCollection{
+        point(1, uint64_t(1)), point(2, uint64_t(2)), point(3, uint64_t(3)), point(4, uint64_t(4)) } });
+
+    // Only the removed feature changes; the ones after it keep drawing in the same order.
+    auto changed = features.update({}, { uint64_t(2) });
+    EXPECT_EQ(std::vector<double>({ 1, 3, 4 }), longitudes(features));
+    ASSERT_EQ(1u, changed.size());
+    EXPECT_DOUBLE_EQ((180.0 + 2) / 360, changed[0].min.x);
+
+    // The features that moved can still be found by their identifier.
+    features.update({ point(5, uint64_t(4)) }, { uint64_t(1) });
+    EXPECT_EQ(std::vector<double>({ 3, 5 }), longitudes(features));
+}
+
+TEST(GeoJSONFeatures, BoundsWithinWorld) {
+    GeoJSONChangedBounds bounds;
+    addWorldBounds(mapbox::geometry::point<double>(0, 0), bounds);
+    ASSERT_EQ(1u, bounds.size());
+    EXPECT_DOUBLE_EQ(0.5, bounds[0].min.x);
+    EXPECT_DOUBLE_EQ(0.5, bounds[0].max.x);
+    EXPECT_DOUBLE_EQ(0.5, bounds[0].min.y);
+}
+
+TEST(GeoJSONFeatures, BoundsWrapped) {
+    // 185° is drawn at -175°.
+    GeoJSONChangedBounds bounds;
+    addWorldBounds(mapbox::geometry::point<double>(185, 0), bounds);
+    ASSERT_EQ(1u, bounds.size());
+    EXPECT_NEAR(5.0 / 360, bounds[0].min.x, 1e-9);
+    EXPECT_NEAR(5.0 / 360, bounds[0].max.x, 1e-9);
+}
+
+TEST(GeoJSONFeatures, BoundsSplitAtAntimeridian) {
+    GeoJSONChangedBounds bounds;
+    addWorldBounds(mapbox::geometry::line_string<double>({ { 170, 10 }, { 190, -10 } }), bounds);
+    ASSERT_EQ(2u, bounds.size());
+    EXPECT_NEAR(350.0 / 360, bounds[0].min.x, 1e-9);
+    EXPECT_DOUBLE_EQ(1, bounds[0].max.x);
+    EXPECT_DOUBLE_EQ(0, bounds[1].min.x);
+    EXPECT_NEAR(10.0 / 360, bounds[1].max.x, 1e-9);
+    EXPECT_EQ(bounds[0].min.y, bounds[1].min.y);
+    EXPECT_EQ(bounds[0].max.y, bounds[1].max.y);
+    EXPECT_LT(bounds[0].min.y, 0.5);
+    EXPECT_GT(bounds[0].max.y, 0.5);
+}
+
+TEST(GeoJSONFeatures, BoundsAcrossWorld) {
+    GeoJSONChangedBounds bounds;
+    addWorldBounds(mapbox::geometry::line_string<double>({ { -180, 0 }, { 180, 0 } }), bounds);
+    ASSERT_EQ(1u, bounds.size());
+    EXPECT_DOUBLE_EQ(0, bounds[0].min.x);
+    EXPECT_DOUBLE_EQ(1, bounds[0].max.x);
+}
+
+TEST(GeoJSONFeatures, BoundsOfEmptyGeometry) {
+    GeoJSONChangedBounds bounds;
+    addWorldBounds(mapbox::geometry::line_string<double>(), bounds);
+    EXPECT_TRUE(bounds.empty());
+}
@@ -3,7 +3,11 @@
 #include <mbgl/style/group_by_layout.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/style/cascade_parameters.hpp>
+#include <mbgl/style/property_evaluation_parameters.hpp>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -42,3 +46,55 @@ TEST(GroupByLayout, UnrelatedLayout) {
     auto result = groupByLayout(layers);
     ASSERT_EQ(2u, result.size());
 }
+
+TEST(GroupByLayout, BucketKey) {
+    LineLayer a("a", "source");
+    LineLayer b("b", "source");
+    const std::string key = bucketKey({ &a, &b });
+
+    EXPECT_EQ(key, bucketKey({ &a, &b }));
+    EXPECT_NE(key, bucketKey({ &a }));
+
+    // Constant paint properties are read at render time.
+    auto evaluate = [] (LineLayer& layer) {
+        layer.impl->cascade({ { ClassID::Default }, TimePoint::min(), {} });
+        layer.impl->evaluate({ 0, TimePoint::min(), ZoomHistory(), Duration::zero() });
+    };
+    b.setLineOpacity(0.5f);
+    evaluate(b);
+    EXPECT_EQ(key, bucketKey({ &a, &b }));
+
+    // Data-driven ones are built into the bucket.
+    b.setLineOpacity(SourceFunction<float>("opacity", IdentityStops<float>()));
+    evaluate(b);
+    EXPECT_NE(key, bucketKey({ &a, &b }));
+
+    // Filters decide which features go into the bucket.
+    const std::string unfiltered = bucketKey({ &a });
+    a.setFilter(EqualsFilter());
+    EXPECT_NE(unfiltered, bucketKey({ &a }));
+}
+
+TEST(GroupByLayout, BucketDependsOnOverscaledZoom) {
+    CircleLayer a("a", "source");
+    CircleLayer b("b", "source");
+    auto evaluate = [] (CircleLayer& layer) {
+        layer.impl->cascade({ { ClassID::Default }, TimePoint::min(), {} });
+        layer.impl->evaluate({ 0, TimePoint::min(), ZoomHistory(), Duration::zero() });
+    };
+    evaluate(a);
+    evaluate(b);
+    EXPECT_FALSE(bucketDependsOnOverscaledZoom({ &a, &b }));
+
+    // The binders of every layer in the group are evaluated at the zoom level of the tile,
+    // not only those of the layer that the group is laid out for.
+    b.setCircleRadius(CompositeFunction<float>("radius",
+        CompositeExponentialStops<float> { { { 0, { { 0, 1 } } }, { 10, { { 0, 10 } } } }, 2 }, 1.0f));
+    evaluate(b);
+    EXPECT_TRUE(bucketDependsOnOverscaledZoom({ &a, &b }));
+    EXPECT_FALSE(bucketDependsOnOverscaledZoom({ &a }));
+
+    // Layers that don't say otherwise depend on it.
+    LineLayer c("c", "source");
+    EXPECT_TRUE(bucketDependsOnOverscaledZoom({ &c }));
+}
@@ -6,6 +6,8 @@
 #include <mbgl/style/sources/raster_source.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/tile/geojson_tile.hpp>
 
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
@@ -22,6 +24,8 @@
 
 #include <mapbox/geojsonvt.hpp>
 
+#include <algorithm>
+
 using namespace mbgl;
 
 class SourceTest {
@@ -33,7 +37,7 @@ public:
     TransformState transformState;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
 
     style::UpdateParameters updateParameters {
         1.0,
@@ -65,6 +69,42 @@ public:
     }
 };
 
+namespace {
+
+// A feature collection with one point feature for every identifier.
+FeatureCollection points(std::vector<uint64_t> ids) {
+    FeatureCollection result;
+    for (auto id : ids) {
+        Feature feature { mapbox::geometry::point<double>{ 1.1, 1.1 } };
+        feature.id = id;
+        result.push_back(std::move(feature));
+    }
+    return result;
+}
+
+// Returns the identifiers of the features the source currently hands to the zoom 0 tile.
+std::vector<uint64_t> tileFeatureIDs(SourceTest& test, GeoJSONSource& source) {
+    const OverscaledTileID tileID { 0, 0, 0 };
+    GeoJSONTile tile(tileID, source.getID(), test.updateParameters);
+    source.impl->setTileData(tile, tileID);
+    tile.setPlacementConfig({}, false);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    std::vector<Feature> features;
+    tile.querySourceFeatures(features, {});
+
+    std::vector<uint64_t> result;
+    for (const auto& feature : features) {
+        result.push_back(feature.id->get<uint64_t>());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
 TEST(Source, LoadingFail) {
     SourceTest test;
 
@@ -85,7 +125,7 @@ TEST(Source, LoadingFail) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -108,7 +148,7 @@ TEST(Source, LoadingCorrupt) {
 
     VectorSource source("source", "url");
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     test.run();
 }
@@ -136,7 +176,7 @@ TEST(Source, RasterTileEmpty) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -165,7 +205,7 @@ TEST(Source, VectorTileEmpty) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -194,7 +234,7 @@ TEST(Source, RasterTileFail) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -223,7 +263,7 @@ TEST(Source, VectorTileFail) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -251,7 +291,7 @@ TEST(Source, RasterTileCorrupt) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -283,7 +323,7 @@ TEST(Source, VectorTileCorrupt) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -310,7 +350,7 @@ TEST(Source, RasterTileCancel) {
 
     RasterSource source("source", tileset, 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -337,7 +377,7 @@ TEST(Source, VectorTileCancel) {
 
     VectorSource source("source", tileset);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -376,7 +416,7 @@ TEST(Source, RasterTileAttribution) {
 
     RasterSource source("source", "url", 512);
     source.baseImpl->setObserver(&test.observer);
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
     source.baseImpl->updateTiles(test.updateParameters);
 
     test.run();
@@ -405,7 +445,7 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
     source.baseImpl->setObserver(&test.observer);
 
     // Load initial, so the source state will be loaded=true
-    source.baseImpl->loadDescription(test.fileSource);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
 
     // Schedule an update
     test.loop.invoke([&] () {
@@ -415,3 +455,115 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
 
     test.run();
 }
+
+TEST(Source, GeoJSONSourceIndexesOnWorker) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+    source.setGeoJSON(GeoJSON{ mapbox::geometry::geometry<double>{ mapbox::geometry::point<double>{ 1.1, 1.1 } } });
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        EXPECT_TRUE(source.baseImpl->isLoaded());
+        test.end();
+    };
+
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    // Indexing happens asynchronously; the source is loaded once the worker replies.
+    EXPECT_FALSE(source.baseImpl->isLoaded());
+
+    test.run();
+}
+
+TEST(Source, GeoJSONSourceDiscardsSupersededIndex) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+    source.setGeoJSON(GeoJSON{ points({ 1 }) });
+
+    test.observer.sourceLoaded = [&] (Source&) {
+        test.end();
+    };
+
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+    test.run();
+
+    // Both updates are indexed, but only the index of the second one is swapped in.
+    int changes = 0;
+    test.observer.sourceChanged = [&] (Source&) {
+        changes++;
+    };
+
+    source.setGeoJSON(GeoJSON{ points({ 2 }) });
+    source.setGeoJSON(GeoJSON{ points({ 3 }) });
+    EXPECT_FALSE(source.baseImpl->isLoaded());
+
+    while (!source.baseImpl->isLoaded()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(1, changes);
+    EXPECT_EQ(std::vector<uint64_t>({ 3 }), tileFeatureIDs(test, source));
+}
+
+TEST(Source, GeoJSONSourceLoadedOnce) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.baseImpl->setObserver(&test.observer);
+    source.setGeoJSON(GeoJSON{ points({ 1 }) });
+
+    // Observers hear about the first load once, and about later data as changes.
+    int loads = 0;
+    int changes = 0;
+    test.observer.sourceLoaded = [&] (Source&) {
+        loads++;
+    };
+    test.observer.sourceChanged = [&] (Source&) {
+        changes++;
+    };
+
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+    while (!source.baseImpl->isLoaded()) {
+        test.loop.runOnce();
+    }
+
+    source.setGeoJSON(GeoJSON{ points({ 2 }) });
+    while (!source.baseImpl->isLoaded()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(1, loads);
+    EXPECT_EQ(1, changes);
+}
+
+TEST(Source, GeoJSONSourceUpdatesBeforeURLData) {
+    SourceTest test;
+
+    test.fileSource.sourceResponse = [&] (const Resource& resource) {
+        EXPECT_EQ("url", resource.url);
+        Response response;
+        response.data = std::make_unique<std::string>(R"JSON({ "type": "FeatureCollection", "features": [
+            { "type": "Feature", "id": 1, "properties": {}, "geometry": { "type": "Point", "coordinates": [1.1, 1.1] } },
+            { "type": "Feature", "id": 2, "properties": {}, "geometry": { "type": "Point", "coordinates": [1.1, 1.1] } }
+        ] })JSON");
+        return response;
+    };
+
+    GeoJSONSource source("source");
+    source.setURL("url");
+    source.baseImpl->setObserver(&test.observer);
+    source.baseImpl->loadDescription(test.fileSource, test.threadPool);
+
+    // Applied to the data of the URL once it arrives, not to the empty source.
+    source.upsertFeatures(points({ 3 }));
+    source.removeFeatures({ uint64_t(1) });
+
+    while (!source.baseImpl->isLoaded()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(std::vector<uint64_t>({ 2, 3 }), tileFeatureIDs(test, source));
+}
@@ -0,0 +1,74 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/geometry/anchor.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+CollisionFeature makeFeature(float x, float y, std::size_t index) {
+    return CollisionFeature({}, Anchor(x, y, 0, 0.5f), -10, 10, -50, 50, 1, 0,
+                            style::SymbolPlacementType::Point,
+                            IndexedSubfeature { uint32_t(index), 0, 0, uint32_t(index) },
+                            false);
+}
+
+} // namespace
+
+TEST(CollisionTile, Placement) {
+    CollisionTile collisionTile(PlacementConfig{});
+
+    auto a = makeFeature(1000, 1000, 0);
+    EXPECT_EQ(collisionTile.minScale, collisionTile.placeFeature(a, false, false));
+    collisionTile.insertFeature(a, collisionTile.minScale, false);
+
+    // Overlaps `a` at scale 1; only fits once zoomed in far enough.
+    auto b = makeFeature(1050, 1000, 1);
+    const float scale = collisionTile.placeFeature(b, false, false);
+    EXPECT_FLOAT_EQ(2.0f, scale);
+
+    // Allowed to overlap.
+    EXPECT_EQ(collisionTile.minScale, collisionTile.placeFeature(b, true, false));
+
+    // Far away from `a`.
+    auto c = makeFeature(4000, 4000, 2);
+    EXPECT_EQ(collisionTile.minScale, collisionTile.placeFeature(c, false, false));
+    collisionTile.insertFeature(c, collisionTile.minScale, false);
+
+    // Boxes in the ignored grid don't block others.
+    auto d = makeFeature(6000, 6000, 3);
+    collisionTile.insertFeature(d, collisionTile.minScale, true);
+    auto e = makeFeature(6000, 6000, 4);
+    EXPECT_EQ(collisionTile.minScale, collisionTile.placeFeature(e, false, false));
+}
+
+TEST(CollisionTile, PlacementOutsideTile) {
+    // Boxes beyond the grid bounds are clamped into the border cells.
+    CollisionTile collisionTile(PlacementConfig{ 1.0f, 0.5f });
+
+    auto a = makeFeature(-20000, 30000, 0);
+    collisionTile.insertFeature(a, collisionTile.minScale, false);
+
+    auto b = makeFeature(-20000, 30000, 1);
+    EXPECT_LT(collisionTile.minScale, collisionTile.placeFeature(b, false, false));
+}
+
+TEST(CollisionTile, QueryRenderedSymbols) {
+    CollisionTile collisionTile(PlacementConfig{});
+
+    auto a = makeFeature(1000, 1000, 0);
+    collisionTile.insertFeature(a, collisionTile.minScale, false);
+    auto b = makeFeature(4000, 4000, 1);
+    collisionTile.insertFeature(b, collisionTile.minScale, true);
+
+    auto result = collisionTile.queryRenderedSymbols({ { 990, 990 }, { 1010, 990 }, { 1010, 1010 }, { 990, 1010 } }, 1);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(0u, result[0].index);
+
+    result = collisionTile.queryRenderedSymbols({ { 0, 0 }, { 8192, 0 }, { 8192, 8192 }, { 0, 8192 } }, 1);
+    EXPECT_EQ(2u, result.size());
+
+    result = collisionTile.queryRenderedSymbols({ { 2000, 2000 }, { 2010, 2000 }, { 2010, 2010 }, { 2000, 2010 } }, 1);
+    EXPECT_TRUE(result.empty());
+}
@@ -147,12 +147,12 @@ TEST(GlyphAtlas, InvalidSDFGlyph) {
     GlyphAtlasTest test;
     GlyphPositions positions;
 
-    auto glyphSet = test.glyphAtlas.getGlyphSet(fontStack);
-    glyphSet->insert(66, SDFGlyph{ 66 /* ASCII 'B' */,
+    GlyphSet glyphSet;
+    glyphSet.insert(66, SDFGlyph{ 66 /* ASCII 'B' */,
                                   AlphaImage({7, 7}), /* correct */
                                   { 1 /* width */, 1 /* height */, 0 /* left */, 0 /* top */,
                                     0 /* advance */ } });
-    glyphSet->insert(67, SDFGlyph{ 67 /* ASCII 'C' */,
+    glyphSet.insert(67, SDFGlyph{ 67 /* ASCII 'C' */,
                                   AlphaImage({518, 8}), /* correct */
                                   { 512 /* width */, 2 /* height */, 0 /* left */, 0 /* top */,
                                     0 /* advance */ } });
@@ -175,3 +175,33 @@ TEST(GlyphAtlas, InvalidSDFGlyph) {
     ASSERT_EQ((Rect<uint16_t>{ 0, 0, 0, 0 }), positions[67].rect);
 
 }
+
+TEST(GlyphAtlas, GlyphSetIsImmutable) {
+    const FontStack fontStack{ "Mock Font" };
+
+    GlyphAtlasTest test;
+
+    auto empty = test.glyphAtlas.getGlyphSet(fontStack);
+    ASSERT_TRUE(empty->getSDFs().empty());
+
+    GlyphSet glyphs;
+    glyphs.insert(66, SDFGlyph{ 66, AlphaImage({7, 7}), { 1, 1, 0, 0, 0 } });
+    test.glyphAtlas.addGlyphSet(fontStack, glyphs);
+
+    // Glyph sets that were handed out before aren't changed.
+    EXPECT_TRUE(empty->getSDFs().empty());
+
+    auto loaded = test.glyphAtlas.getGlyphSet(fontStack);
+    ASSERT_EQ(1u, loaded->getSDFs().size());
+
+    GlyphSet more;
+    more.insert(67, SDFGlyph{ 67, AlphaImage({7, 7}), { 1, 1, 0, 0, 0 } });
+    test.glyphAtlas.addGlyphSet(fontStack, more);
+
+    EXPECT_EQ(1u, loaded->getSDFs().size());
+
+    // The glyphs are shared with the new glyph set.
+    auto updated = test.glyphAtlas.getGlyphSet(fontStack);
+    ASSERT_EQ(2u, updated->getSDFs().size());
+    EXPECT_EQ(loaded->getSDFs().at(66), updated->getSDFs().at(66));
+}
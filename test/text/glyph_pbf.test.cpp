@@ -51,7 +51,7 @@ TEST(GlyphPBF, Parsing) {
 
         EXPECT_TRUE(sdfs.size() == 1);
         EXPECT_TRUE(sdfs.find(69) != sdfs.end());
-        auto& sdf = sdfs.at(69);
+        auto& sdf = *sdfs.at(69);
         AlphaImage expected({7, 7});
         expected.fill('x');
         EXPECT_EQ(expected, sdf.bitmap);
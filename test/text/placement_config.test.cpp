@@ -0,0 +1,27 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/placement_config.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+TEST(PlacementConfig, IsCloseTo) {
+    const float degree = util::DEG2RAD;
+    const PlacementConfig config { 10 * degree, 30 * degree, false };
+
+    EXPECT_TRUE(config.isCloseTo(config));
+    EXPECT_TRUE(config.isCloseTo({ 10.5f * degree, 30 * degree, false }));
+    EXPECT_TRUE(config.isCloseTo({ 10 * degree, 29.5f * degree, false }));
+
+    EXPECT_FALSE(config.isCloseTo({ 12 * degree, 30 * degree, false }));
+    EXPECT_FALSE(config.isCloseTo({ 10 * degree, 32 * degree, false }));
+    EXPECT_FALSE(config.isCloseTo({ 10 * degree, 30 * degree, true }));
+}
+
+TEST(PlacementConfig, IsCloseToWrapsAngle) {
+    const float degree = util::DEG2RAD;
+    const PlacementConfig config { 179.8f * degree, 0, false };
+
+    EXPECT_TRUE(config.isCloseTo({ -179.8f * degree, 0, false }));
+    EXPECT_FALSE(config.isCloseTo({ -170 * degree, 0, false }));
+}
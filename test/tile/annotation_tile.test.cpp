@@ -24,7 +24,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
 
     style::UpdateParameters updateParameters {
         1.0,
@@ -57,7 +57,7 @@ TEST(AnnotationTile, Issue8289) {
 
     auto collisionTile = std::make_unique<CollisionTile>(PlacementConfig());
 
-    IndexedSubfeature subfeature { 0, "", "", 0 };
+    IndexedSubfeature subfeature { 0, 0, 0, 0 };
     CollisionFeature feature(GeometryCoordinates(), Anchor(0, 0, 0, 0), -5, 5, -5, 5, 1, 0, style::SymbolPlacementType::Point, subfeature, false);
     collisionTile->insertFeature(feature, 0, true);
     collisionTile->placeFeature(feature, false, false);
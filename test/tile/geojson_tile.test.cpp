@@ -11,6 +11,7 @@
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <memory>
 
@@ -24,7 +25,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     style::UpdateParameters updateParameters {
@@ -53,7 +54,7 @@ TEST(GeoJSONTile, Issue7648) {
     };
     tile.setObserver(&observer);
 
-    tile.setPlacementConfig({});
+    tile.setPlacementConfig({}, false);
 
     mapbox::geometry::feature_collection<int16_t> features;
     features.push_back(mapbox::geometry::feature<int16_t> {
@@ -70,3 +71,81 @@ TEST(GeoJSONTile, Issue7648) {
         test.loop.runOnce();
     }
 }
+
+TEST(GeoJSONTile, FinalPlacementMatchesCamera) {
+    GeoJSONTileTest test;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.updateParameters);
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+
+    tile.updateData(features);
+    tile.setPlacementConfig({}, false);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+    EXPECT_EQ(PlacementConfig(), *tile.getPlacementConfig());
+
+    // While the camera rotates, a placement within the tolerance is kept.
+    const PlacementConfig rotated { 0.5f * util::DEG2RAD, 0, false };
+    tile.setPlacementConfig(rotated, true);
+    EXPECT_TRUE(tile.isComplete());
+
+    // Once it stops, symbols are placed for the final camera.
+    tile.setPlacementConfig(rotated, false);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+    EXPECT_EQ(rotated, *tile.getPlacementConfig());
+
+    // Still renders compare exactly, so the same camera always gives the same placement.
+    tile.setPlacementConfig({}, false);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+    EXPECT_EQ(PlacementConfig(), *tile.getPlacementConfig());
+}
+
+TEST(GeoJSONTile, RelayoutKeepsUnchangedBuckets) {
+    GeoJSONTileTest test;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.updateParameters);
+
+    test.style.addLayer(std::make_unique<CircleLayer>("a", "source"));
+    auto b = std::make_unique<CircleLayer>("b", "source");
+    b->setFilter(NotHasFilter { "x" });
+    test.style.addLayer(std::move(b));
+
+    const Layer& a = *test.style.getLayer("a");
+    CircleLayer& changed = *test.style.getLayer("b")->as<CircleLayer>();
+
+    tile.setPlacementConfig({}, false);
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+
+    tile.updateData(features);
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    Bucket* bucketA = tile.getBucket(a);
+    Bucket* bucketB = tile.getBucket(changed);
+    ASSERT_NE(nullptr, bucketA);
+    ASSERT_NE(nullptr, bucketB);
+
+    // Only the group whose filter changed is laid out again. The tile holds on to the old
+    // bucket until the new one arrives, so a rebuilt bucket has a different address.
+    changed.setFilter(NotHasFilter { "y" });
+    tile.redoLayout();
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(bucketA, tile.getBucket(a));
+    EXPECT_NE(nullptr, tile.getBucket(changed));
+    EXPECT_NE(bucketB, tile.getBucket(changed));
+}
@@ -0,0 +1,99 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/layout_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<const GeometryTileData> readTileData() {
+    return std::make_shared<VectorTileData>(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+}
+
+// Data whose comparison uses the cache, which only works if the cache doesn't hold its lock
+// while comparing.
+class ReentrantTileData : public GeometryTileData {
+public:
+    ReentrantTileData(LayoutCache& cache_) : cache(cache_) {}
+
+    const GeometryTileLayer* getLayer(const std::string&) const override { return nullptr; }
+
+    bool sameContents(const GeometryTileData& other) const override {
+        cache.getGroup(other, "water");
+        return dynamic_cast<const ReentrantTileData*>(&other) != nullptr;
+    }
+
+private:
+    LayoutCache& cache;
+};
+
+} // namespace
+
+TEST(LayoutCache, ShareData) {
+    LayoutCache cache;
+    const CanonicalTileID tileID { 10, 163, 395 };
+
+    // Separately loaded copies of the same tile share the data of the first one.
+    auto first = readTileData();
+    auto second = readTileData();
+    EXPECT_EQ(first, cache.shareData("streets", tileID, first));
+    EXPECT_EQ(first, cache.shareData("streets", tileID, second));
+
+    // Other tiles and other sources don't.
+    EXPECT_EQ(second, cache.shareData("streets", { 10, 163, 396 }, second));
+    EXPECT_EQ(second, cache.shareData("satellite", tileID, second));
+
+    // Reloaded data with other contents replaces the previous data.
+    std::shared_ptr<const GeometryTileData> other =
+        std::make_shared<VectorTileData>(std::make_shared<std::string>());
+    EXPECT_EQ(other, cache.shareData("streets", tileID, other));
+    EXPECT_EQ(other, cache.shareData("streets", tileID, other));
+
+    // So does data once no tile uses the previous data anymore.
+    other.reset();
+    EXPECT_EQ(second, cache.shareData("streets", tileID, second));
+
+    EXPECT_EQ(nullptr, cache.shareData("streets", tileID, nullptr));
+}
+
+TEST(LayoutCache, ShareDataComparesWithoutLock) {
+    LayoutCache cache;
+    const CanonicalTileID tileID { 10, 163, 395 };
+
+    std::shared_ptr<const GeometryTileData> first = std::make_shared<ReentrantTileData>(cache);
+    EXPECT_EQ(first, cache.shareData("streets", tileID, first));
+    EXPECT_EQ(first, cache.shareData("streets", tileID, std::make_shared<ReentrantTileData>(cache)));
+
+    auto other = readTileData();
+    EXPECT_EQ(other, cache.shareData("streets", tileID, other));
+    EXPECT_EQ(other, cache.shareData("streets", tileID, other));
+}
+
+TEST(LayoutCache, Groups) {
+    LayoutCache cache;
+    auto data = readTileData();
+
+    EXPECT_EQ(nullptr, cache.getGroup(*data, "water"));
+
+    auto group = std::make_shared<LayoutGroup>();
+    group->data = data;
+    EXPECT_EQ(group, cache.addGroup("water", group));
+    EXPECT_EQ(group, cache.getGroup(*data, "water"));
+    EXPECT_EQ(nullptr, cache.getGroup(*data, "water@16"));
+    EXPECT_EQ(nullptr, cache.getGroup(*readTileData(), "water"));
+
+    // A group laid out at the same time by another tile yields to the one added first.
+    auto concurrent = std::make_shared<LayoutGroup>();
+    concurrent->data = data;
+    EXPECT_EQ(group, cache.addGroup("water", concurrent));
+
+    // Groups go away with the last tile using them.
+    group.reset();
+    EXPECT_EQ(nullptr, cache.getGroup(*data, "water"));
+    EXPECT_EQ(concurrent, cache.addGroup("water", concurrent));
+}
@@ -0,0 +1,42 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/tile/tile.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class StubTile : public Tile {
+public:
+    StubTile(OverscaledTileID id_) : Tile(id_) {
+        availableData = DataAvailability::All;
+    }
+
+    void setNecessity(Necessity) override {}
+    void cancel() override {}
+    Bucket* getBucket(const style::Layer&) override { return nullptr; }
+};
+
+} // namespace
+
+TEST(TileCache, Remove) {
+    TileCache cache(3);
+    for (uint32_t x = 0; x < 3; ++x) {
+        cache.add({ 3, x, 0 }, std::make_unique<StubTile>(OverscaledTileID(3, x, 0)));
+    }
+
+    cache.remove([] (const OverscaledTileID& id) {
+        return id.canonical.x == 1;
+    });
+
+    EXPECT_TRUE(cache.has({ 3, 0, 0 }));
+    EXPECT_FALSE(cache.has({ 3, 1, 0 }));
+    EXPECT_TRUE(cache.has({ 3, 2, 0 }));
+
+    // The remaining tiles keep their order, so the oldest one is evicted first.
+    cache.add({ 3, 3, 0 }, std::make_unique<StubTile>(OverscaledTileID(3, 3, 0)));
+    cache.add({ 3, 4, 0 }, std::make_unique<StubTile>(OverscaledTileID(3, 4, 0)));
+    EXPECT_FALSE(cache.has({ 3, 0, 0 }));
+    EXPECT_TRUE(cache.has({ 3, 2, 0 }));
+}
@@ -2,9 +2,11 @@
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/update_parameters.hpp>
@@ -25,7 +27,7 @@ public:
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     AnnotationManager annotationManager { 1.0 };
-    style::Style style { fileSource, 1.0 };
+    style::Style style { threadPool, fileSource, 1.0 };
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     style::UpdateParameters updateParameters {
@@ -86,3 +88,65 @@ TEST(VectorTile, Issue7615) {
 
     EXPECT_EQ(symbolBucket.get(), tile.getBucket(symbolLayer));
 }
+
+TEST(VectorTile, KeyIndex) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    const GeometryTileLayer* layer = data.getLayer("road");
+    ASSERT_NE(nullptr, layer);
+
+    const std::vector<std::string> keys = { "class", "oneway", "structure", "type", "name", "" };
+
+    // The same key resolves to the same index for every feature of the layer.
+    std::unique_ptr<GeometryTileFeature> first = layer->getFeature(0);
+    for (const auto& key : keys) {
+        ASSERT_TRUE(bool(first->getKeyIndex(key)));
+        for (std::size_t i = 1; i < layer->featureCount(); i++) {
+            EXPECT_EQ(*first->getKeyIndex(key), *layer->getFeature(i)->getKeyIndex(key));
+        }
+    }
+
+    GeometryTileLayerKeys layerKeys;
+    for (std::size_t i = 0; i < layer->featureCount(); i++) {
+        std::unique_ptr<GeometryTileFeature> feature = layer->getFeature(i);
+        for (const auto& key : keys) {
+            EXPECT_EQ(feature->getValue(key), layerKeys.getValue(*feature, key).toOptional());
+            EXPECT_EQ(feature->getValue(key), feature->lookupValue(key).toOptional());
+            EXPECT_EQ(feature->getValue(key), KeyedGeometryTileFeature(*feature, layerKeys).getValue(key));
+        }
+    }
+
+    // Keys are resolved by the string object, so equal keys of different filters or functions
+    // each get a slot of their own that finds the same value.
+    const std::string otherClass = "class";
+    EXPECT_EQ(first->getValue("class"), layerKeys.getValue(*first, otherClass).toOptional());
+    EXPECT_EQ(first->getValue("class"), layerKeys.getValue(*first, keys[0]).toOptional());
+
+    // A key that doesn't occur in the layer resolves, but never matches.
+    EXPECT_FALSE(bool(first->getIndexedValue(*first->getKeyIndex("name"))));
+    EXPECT_TRUE(bool(first->getIndexedValue(*first->getKeyIndex("class"))));
+
+    // Values are read in place, so reading one again refers to the same value.
+    EXPECT_EQ(first->getIndexedValue(*first->getKeyIndex("class")),
+              &*first->lookupValue("class"));
+}
+
+TEST(VectorTile, VisitGeometries) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    GeometryCoordinates buffer;
+    for (const auto& name : { "landcover", "road", "poi_label" }) {
+        const GeometryTileLayer* layer = data.getLayer(name);
+        ASSERT_NE(nullptr, layer);
+
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            std::unique_ptr<GeometryTileFeature> feature = layer->getFeature(i);
+
+            GeometryCollection visited;
+            feature->visitGeometries(buffer, [&] (const GeometryCoordinates& line) {
+                visited.push_back(line);
+            });
+            EXPECT_EQ(feature->getGeometries(), visited);
+        }
+    }
+}
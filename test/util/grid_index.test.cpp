@@ -0,0 +1,41 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/grid_index.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+std::vector<std::size_t> query(const GridIndex<IndexedSubfeature>& grid, const GridIndex<IndexedSubfeature>::BBox& bbox) {
+    std::vector<std::size_t> result;
+    grid.query(bbox, [&](const IndexedSubfeature& feature) {
+        result.push_back(feature.index);
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(GridIndex, Query) {
+    GridIndex<IndexedSubfeature> grid(100, 10, 0);
+
+    grid.insert(IndexedSubfeature { 0, 0, 0, 0 }, { { 5, 5 }, { 8, 8 } });
+    // Spans many cells, but must be reported once.
+    grid.insert(IndexedSubfeature { 1, 0, 0, 1 }, { { 10, 10 }, { 90, 90 } });
+    grid.insert(IndexedSubfeature { 2, 0, 0, 2 }, { { 95, 95 }, { 99, 99 } });
+
+    // Nothing is found before the index is built.
+    EXPECT_EQ((std::vector<std::size_t>{}), query(grid, { { 0, 0 }, { 100, 100 } }));
+
+    grid.build();
+
+    EXPECT_EQ((std::vector<std::size_t>{ 0, 1, 2 }), query(grid, { { 0, 0 }, { 100, 100 } }));
+    EXPECT_EQ((std::vector<std::size_t>{ 0 }), query(grid, { { 0, 0 }, { 6, 6 } }));
+    EXPECT_EQ((std::vector<std::size_t>{ 1 }), query(grid, { { 40, 40 }, { 60, 60 } }));
+    EXPECT_EQ((std::vector<std::size_t>{ 1, 2 }), query(grid, { { 85, 85 }, { 96, 96 } }));
+    EXPECT_EQ((std::vector<std::size_t>{}), query(grid, { { 91, 0 }, { 100, 90 } }));
+}
@@ -128,3 +128,101 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(127, image.data[2]);
     EXPECT_EQ(128, image.data[3]);
 }
+
+TEST(Image, PremultiplyEveryValue) {
+    // One pixel for every combination of color and alpha, and some more so that the last pixels
+    // don't fill a vector.
+    const uint32_t width = 256 * 256 + 3;
+    UnassociatedImage rgba({ width, 1 });
+    for (uint32_t i = 0; i < width; i++) {
+        rgba.data[4 * i + 0] = i % 256;
+        rgba.data[4 * i + 1] = 255 - i % 256;
+        rgba.data[4 * i + 2] = (i * 7) % 256;
+        rgba.data[4 * i + 3] = (i / 256) % 256;
+    }
+    const UnassociatedImage expected = rgba.clone();
+
+    PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        const uint8_t a = expected.data[i + 3];
+        ASSERT_EQ((expected.data[i + 0] * a + 127) / 255, image.data[i + 0]);
+        ASSERT_EQ((expected.data[i + 1] * a + 127) / 255, image.data[i + 1]);
+        ASSERT_EQ((expected.data[i + 2] * a + 127) / 255, image.data[i + 2]);
+        ASSERT_EQ(a, image.data[i + 3]);
+    }
+}
+
+TEST(Image, Unpremultiply) {
+    PremultipliedImage rgba({ 2, 1 });
+    rgba.data[0] = 128;
+    rgba.data[1] = 127;
+    rgba.data[2] = 0;
+    rgba.data[3] = 128;
+    rgba.data[4] = 10;
+    rgba.data[5] = 20;
+    rgba.data[6] = 30;
+    rgba.data[7] = 0;
+
+    UnassociatedImage image = util::unpremultiply(std::move(rgba));
+    EXPECT_EQ(255, image.data[0]);
+    EXPECT_EQ(253, image.data[1]);
+    EXPECT_EQ(0, image.data[2]);
+    EXPECT_EQ(128, image.data[3]);
+
+    // Pixels without alpha are kept as they are.
+    EXPECT_EQ(10, image.data[4]);
+    EXPECT_EQ(20, image.data[5]);
+    EXPECT_EQ(30, image.data[6]);
+    EXPECT_EQ(0, image.data[7]);
+}
+
+TEST(Image, UnpremultiplyEveryValue) {
+    const uint32_t width = 256 * 256 + 3;
+    PremultipliedImage rgba({ width, 1 });
+    for (uint32_t i = 0; i < width; i++) {
+        const uint8_t a = (i / 256) % 256;
+        rgba.data[4 * i + 0] = i % 256;
+        rgba.data[4 * i + 1] = std::min<uint32_t>(a, i % 256);
+        rgba.data[4 * i + 2] = a;
+        rgba.data[4 * i + 3] = a;
+    }
+    const PremultipliedImage expected = rgba.clone();
+
+    UnassociatedImage image = util::unpremultiply(std::move(rgba));
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        const uint8_t a = expected.data[i + 3];
+        for (std::size_t c = 0; c < 3; c++) {
+            const uint8_t value = expected.data[i + c];
+            ASSERT_EQ(a ? uint8_t((255 * value + a / 2) / a) : value, image.data[i + c]);
+        }
+        ASSERT_EQ(a, image.data[i + 3]);
+    }
+}
+
+TEST(Image, CopyData) {
+    PremultipliedImage src({ 4, 3 });
+    for (std::size_t i = 0; i < src.bytes(); i++) {
+        src.data[i] = i;
+    }
+
+    // Whole rows.
+    PremultipliedImage rows({ 4, 4 });
+    rows.fill(255);
+    PremultipliedImage::copy(src, rows, { 0, 1 }, { 0, 2 }, { 4, 2 });
+    EXPECT_EQ(255, rows.data[2 * rows.stride() - 1]);
+    for (std::size_t i = 0; i < 2 * src.stride(); i++) {
+        EXPECT_EQ(src.data[src.stride() + i], rows.data[2 * rows.stride() + i]);
+    }
+
+    // Part of each row.
+    PremultipliedImage part({ 3, 2 });
+    part.fill(255);
+    PremultipliedImage::copy(src, part, { 2, 1 }, { 1, 0 }, { 2, 2 });
+    for (uint32_t y = 0; y < 2; y++) {
+        EXPECT_EQ(255, part.data[y * part.stride()]);
+        for (std::size_t i = 0; i < 2 * PremultipliedImage::channels; i++) {
+            EXPECT_EQ(src.data[(y + 1) * src.stride() + 2 * 4 + i],
+                      part.data[y * part.stride() + 4 + i]);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/io.hpp>
+
+#include <thread>
+
+#include <sys/stat.h>
+
+using namespace mbgl;
+
+TEST(IO, ReadFile) {
+    const std::string path = "test/fixtures/storage/io.bin";
+    const std::string data("binary\0data\r\n", 13);
+    util::write_file(path, data);
+    EXPECT_EQ(data, util::read_file(path));
+    util::deleteFile(path);
+
+    EXPECT_THROW(util::read_file(path), std::runtime_error);
+}
+
+TEST(IO, ReadFIFO) {
+    // FIFOs don't have a size, so they are read until the writer closes them.
+    const std::string path = "test/fixtures/storage/io.fifo";
+    ASSERT_EQ(0, mkfifo(path.c_str(), 0600));
+
+    const std::string data(100000, 'x');
+    std::thread writer([&] {
+        util::write_file(path, data);
+    });
+
+    EXPECT_EQ(data, util::read_file(path));
+
+    writer.join();
+    util::deleteFile(path);
+}
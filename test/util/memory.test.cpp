@@ -6,7 +6,10 @@
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/style/conversion/geojson_reader.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 #include <algorithm>
@@ -163,3 +166,92 @@ TEST(Memory, Footprint) {
     ASSERT_LT(rasterFootprint, 25 * 1024 * 1024) << "\
         mbgl::Map footprint over 25MB for raster styles.";
 }
+
+// Compares the peak memory used to turn a large GeoJSON string into features with the
+// streaming reader and with a JSON document.
+TEST(Memory, GeoJSONPeakRSS) {
+    if (!shouldRunFootprint()) {
+        return;
+    }
+
+    std::string json = R"JSON({"type":"FeatureCollection","features":[)JSON";
+    for (unsigned i = 0; i < 200000; ++i) {
+        if (i) json += ",";
+        json += R"JSON({"type":"Feature","id":)JSON" + std::to_string(i) +
+                R"JSON(,"properties":{"name":"feature )JSON" + std::to_string(i) +
+                R"JSON("},"geometry":{"type":"LineString","coordinates":[[)JSON" +
+                std::to_string(i % 360 - 180) + R"JSON(,10.25],[)JSON" +
+                std::to_string(i % 360 - 179) + R"JSON(,11.75]]}})JSON";
+    }
+    json += "]}";
+
+    // Peak RSS never goes down, so both measurements are relative to the same baseline;
+    // the document-based conversion only raises the peak if it needs more memory.
+    const long baseRSS = mbgl::test::getPeakRSS();
+
+    {
+        auto geoJSON = style::conversion::parseGeoJSON(json);
+        ASSERT_TRUE(bool(geoJSON));
+    }
+    const long streamingRSS = mbgl::test::getPeakRSS() - baseRSS;
+
+    {
+        JSDocument document;
+        document.Parse<0>(json.c_str());
+        ASSERT_FALSE(document.HasParseError());
+        auto geoJSON = style::conversion::convertGeoJSON<JSValue>(document);
+        ASSERT_TRUE(bool(geoJSON));
+    }
+    const long documentRSS = mbgl::test::getPeakRSS() - baseRSS;
+
+    RecordProperty("streamingPeakKB", streamingRSS / 1024);
+    RecordProperty("documentPeakKB", documentRSS / 1024);
+
+    ASSERT_LT(streamingRSS, documentRSS) << "\
+        Streaming GeoJSON parsing should peak below document-based parsing.";
+}
+
+// Measures how much memory each further level of overscaling takes once a vector source has run
+// out of zoom levels. The tiles of all levels stay in the tile cache, and share the data and the
+// fill and circle buckets of their canonical tile.
+TEST(Memory, OverscaledVectorFootprint) {
+    if (!shouldRunFootprint()) {
+        return;
+    }
+
+    MemoryTest test;
+
+    test.fileSource.sourceResponse = [&](const Resource&) {
+        std::string source = util::read_file("test/fixtures/resources/source_vector.json");
+        const std::string maxzoom = R"JSON("maxzoom":16)JSON";
+        source.replace(source.find(maxzoom), maxzoom.size(), R"JSON("maxzoom":14)JSON");
+
+        Response response;
+        response.data = std::make_shared<std::string>(std::move(source));
+        return response;
+    };
+
+    const long initialRSS = mbgl::test::getCurrentRSS();
+
+    Map map(test.backend, { 256, 256 }, 2, test.fileSource, test.threadPool, MapMode::Still);
+    map.setZoom(18);
+    map.setStyleURL("mapbox://streets");
+    test::render(map, test.view);
+
+    const long firstLevelRSS = mbgl::test::getCurrentRSS();
+
+    const unsigned levels = 4;
+    for (unsigned i = 1; i <= levels; ++i) {
+        map.setZoom(18 + i);
+        test::render(map, test.view);
+    }
+
+    const double firstLevelFootprint = firstLevelRSS - initialRSS;
+    const double levelFootprint = (mbgl::test::getCurrentRSS() - firstLevelRSS) / double(levels);
+
+    RecordProperty("firstLevelFootprint", firstLevelFootprint);
+    RecordProperty("levelFootprint", levelFootprint);
+
+    ASSERT_LT(levelFootprint, firstLevelFootprint) << "\
+        Overscaled levels should reuse the data and buckets of their canonical tiles.";
+}
@@ -0,0 +1,125 @@
+#include <mbgl/util/monotonic_arena.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <cstdint>
+#include <list>
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+namespace {
+
+class Counted {
+public:
+    Counted(int& count_) : count(count_) { count++; }
+    ~Counted() { count--; }
+
+    int& count;
+};
+
+} // namespace
+
+TEST(MonotonicArena, Alignment) {
+    MonotonicArena arena(64);
+
+    arena.allocate(1, 1);
+    void* aligned = arena.allocate(8, 8);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(aligned) % 8);
+
+    arena.allocate(3, 1);
+    aligned = arena.allocate(sizeof(double), alignof(std::max_align_t));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(aligned) % alignof(std::max_align_t));
+}
+
+TEST(MonotonicArena, DestroysObjectsOnReset) {
+    MonotonicArena arena;
+    int count = 0;
+
+    Counted* counted = arena.make<Counted>(count);
+    arena.make<Counted>(count);
+    EXPECT_EQ(&count, &counted->count);
+    EXPECT_EQ(2, count);
+
+    std::string* string = arena.make<std::string>(100, 'x');
+    EXPECT_EQ(100u, string->size());
+
+    arena.reset();
+    EXPECT_EQ(0, count);
+
+    {
+        MonotonicArena other;
+        other.make<Counted>(count);
+        EXPECT_EQ(1, count);
+    }
+    EXPECT_EQ(0, count);
+}
+
+TEST(MonotonicArena, MergesChunksOnReset) {
+    MonotonicArena arena(64);
+    EXPECT_EQ(0u, arena.capacity());
+
+    for (int i = 0; i < 100; i++) {
+        arena.allocate(16);
+    }
+    const std::size_t capacity = arena.capacity();
+    EXPECT_LE(1600u, capacity);
+
+    // The next round of the same size fits into a single chunk of the same capacity.
+    arena.reset();
+    EXPECT_EQ(capacity, arena.capacity());
+
+    void* first = arena.allocate(16);
+    for (int i = 1; i < 100; i++) {
+        arena.allocate(16);
+    }
+    EXPECT_EQ(capacity, arena.capacity());
+
+    arena.reset();
+    EXPECT_EQ(first, arena.allocate(16));
+}
+
+TEST(MonotonicArena, Release) {
+    MonotonicArena arena(64);
+    int count = 0;
+
+    arena.make<Counted>(count);
+    for (int i = 0; i < 100; i++) {
+        arena.allocate(16);
+    }
+    EXPECT_LT(0u, arena.capacity());
+
+    arena.release();
+    EXPECT_EQ(0, count);
+    EXPECT_EQ(0u, arena.capacity());
+
+    // Still usable afterwards.
+    arena.make<Counted>(count);
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(64u, arena.capacity());
+}
+
+TEST(MonotonicArena, Allocator) {
+    MonotonicArena arena(64);
+
+    for (int round = 0; round < 3; round++) {
+        {
+            std::list<int, ArenaAllocator<int>> list { ArenaAllocator<int>(arena) };
+            for (int i = 0; i < 100; i++) {
+                list.push_back(i);
+            }
+            list.pop_front();
+
+            EXPECT_EQ(99u, list.size());
+            EXPECT_EQ(1, list.front());
+            EXPECT_EQ(99, list.back());
+        }
+        arena.reset();
+    }
+
+    EXPECT_EQ(ArenaAllocator<int>(arena), ArenaAllocator<double>(arena));
+
+    MonotonicArena other;
+    EXPECT_NE(ArenaAllocator<int>(arena), ArenaAllocator<int>(other));
+}
@@ -0,0 +1,71 @@
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ParallelFor, CallsEveryIndexOnce) {
+    ThreadPool pool { 4 };
+    std::vector<std::atomic<int>> calls(1000);
+
+    util::parallelFor(pool, calls.size(), [&] (std::size_t i) {
+        calls[i]++;
+    });
+
+    for (const auto& count : calls) {
+        EXPECT_EQ(1, count.load());
+    }
+
+    util::parallelFor(pool, 0, [&] (std::size_t) {
+        FAIL();
+    });
+}
+
+TEST(ParallelFor, FromBusyScheduler) {
+    // The only thread of the pool runs the caller, so the caller has to make progress by itself.
+
+    struct Test {
+        Test(ActorRef<Test>, Scheduler& scheduler_) : scheduler(scheduler_) {}
+
+        void run(std::promise<std::size_t> promise) {
+            std::atomic<std::size_t> sum { 0 };
+            util::parallelFor(scheduler, 100, [&] (std::size_t i) {
+                sum += i;
+            });
+            promise.set_value(sum.load());
+        }
+
+        Scheduler& scheduler;
+    };
+
+    ThreadPool pool { 1 };
+    Actor<Test> test(pool, pool);
+
+    std::promise<std::size_t> promise;
+    auto result = promise.get_future();
+    test.invoke(&Test::run, std::move(promise));
+
+    EXPECT_EQ(4950u, result.get());
+}
+
+TEST(ParallelFor, Exception) {
+    ThreadPool pool { 4 };
+    std::atomic<std::size_t> calls { 0 };
+
+    EXPECT_THROW(util::parallelFor(pool, 10, [&] (std::size_t i) {
+        calls++;
+        if (i == 3) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+
+    // The other calls finish nonetheless.
+    EXPECT_EQ(10u, calls.load());
+}